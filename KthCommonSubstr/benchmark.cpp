@@ -0,0 +1,86 @@
+/*
+ CommonSubstrings на строках суммарной длины 2 * 10^6: отдельно GeneralizedSuffixArray двух строк
+ (SA-IS над символами uint32_t + LCP), затем всё построение (он же + common)
+ и запрос k-й подстроки для k в середине и в конце лексикографического порядка,
+ пачка из BATCH случайных k через KthBatch против BATCH отдельных Kth.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common_substrings.h"
+
+const size_t LENGTH = 1000000;
+const size_t BATCH = 1000;
+
+template <class Function>
+double Milliseconds(Function&& function) {
+    auto begin = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - begin;
+    return time.count();
+}
+
+std::string Random(std::mt19937& generator, size_t alphabet_size) {
+    std::string result(LENGTH, 'a');
+    for (auto& ch : result) {
+        ch = static_cast<char>('a' + generator() % alphabet_size);
+    }
+    return result;
+}
+
+std::string Fibonacci(size_t length) {
+    std::string prev = "a";
+    std::string current = "ab";
+    while (current.length() < length) {
+        std::string next = current + prev;
+        prev = std::move(current);
+        current = std::move(next);
+    }
+    current.resize(length);
+    return current;
+}
+
+void Report(const char* name, const std::string& first, const std::string& second) {
+    double suffix_array_time = Milliseconds([&] { GeneralizedSuffixArray<uint32_t>({first, second}); });
+    std::optional<CommonSubstrings<uint32_t>> common;
+    double build_time = Milliseconds([&] { common.emplace(first, second); });
+    const uint64_t count = common->Count();
+    size_t middle_length = 0;
+    size_t last_length = 0;
+    double middle_time = Milliseconds([&] { middle_length = common->Kth(count / 2 + 1)->length(); });
+    double last_time = Milliseconds([&] { last_length = common->Kth(count)->length(); });
+    std::mt19937_64 generator(2);
+    std::vector<uint64_t> k_values(BATCH);
+    for (auto& k : k_values) {
+        k = generator() % count + 1;
+    }
+    std::vector<std::optional<std::string>> batch;
+    double batch_time = Milliseconds([&] { batch = common->KthBatch(k_values); });
+    bool same = true;
+    double single_time = Milliseconds([&] {
+        for (size_t i = 0; i < BATCH; ++i) {
+            same &= common->Kth(k_values[i]) == batch[i];
+        }
+    });
+    printf("%-12s generalized sa: %6.1f ms | build: %6.1f ms | %llu common | kth middle: %6.3f ms (len %zu), "
+           "last: %6.3f ms (len %zu) | %zu k: batch %6.1f ms, one by one %7.1f ms%s\n",
+           name, suffix_array_time, build_time, static_cast<unsigned long long>(count),
+           middle_time, middle_length, last_time, last_length, BATCH, batch_time, single_time,
+           same ? "" : " MISMATCH");
+}
+
+int main() {
+    std::mt19937 generator(1);
+    Report("random 2", Random(generator, 2), Random(generator, 2));
+    Report("random 26", Random(generator, 26), Random(generator, 26));
+    std::string fibonacci = Fibonacci(2 * LENGTH);
+    Report("fibonacci", fibonacci.substr(0, LENGTH), fibonacci.substr(LENGTH));
+    Report("a^n", std::string(LENGTH, 'a'), std::string(LENGTH, 'a'));
+    return 0;
+}
@@ -0,0 +1,127 @@
+#ifndef KTHCOMMONSUBSTR_COMMON_SUBSTRINGS_H
+#define KTHCOMMONSUBSTR_COMMON_SUBSTRINGS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "generalized_suffix_array.h"
+
+/*
+ Общие подстроки двух строк в лексикографическом порядке.
+ Основа - GeneralizedSuffixArray двух строк: разделители уникальны и не входят ни в одно LCP.
+ Подстроки, впервые появляющиеся в sa[r], - префиксы суффикса sa[r] длины больше lcp[r]. Префикс общий, если не длиннее common[r] - наибольшего LCP с суффиксом
+ другой строки; он достигается на ближайшем такой суффиксе слева или справа (два прохода).
+ Значит, в sa[r] впервые появляются max(0, common[r] - lcp[r]) общих подстрок, и обход sa по порядку
+ перечисляет общие подстроки лексикографически.
+ Префиксные суммы числа новых общих подстрок по рангам хранятся: Kth ищет в них ранг двоичным поиском.
+ KthBatch сортирует k и ищет ранги в тех же префиксных суммах галопом от ранга предыдущего k,
+ так что пачка не медленнее q отдельных Kth, а на плотных k - быстрее.
+ Time: O(|first| + |second|) preprocessing, O(log n + ответ) per Kth,
+       O(q log q + q log(n / q) + ответ) per KthBatch
+ Memory: O(|first| + |second|)
+ */
+template <class Index = uint32_t>
+class CommonSubstrings {
+public:
+    CommonSubstrings(const std::string& first, const std::string& second);
+
+    // Число различных общих подстрок
+    uint64_t Count() const;
+
+    // k-я (с единицы) в лексикографическом порядке общая подстрока, пусто, если k > Count()
+    std::optional<std::string> Kth(uint64_t k) const;
+
+    // Ответы на все k сразу, в порядке k_values; k_values могут быть не отсортированы
+    std::vector<std::optional<std::string>> KthBatch(const std::vector<uint64_t>& k_values) const;
+
+    ~CommonSubstrings() = default;
+
+private:
+    GeneralizedSuffixArray<Index> suffix_array;
+    std::vector<Index> common;
+    std::vector<uint64_t> passed;  // passed[r] - число общих подстрок, впервые появившихся в рангах до r
+    uint64_t count;
+};
+
+template <class Index>
+CommonSubstrings<Index>::CommonSubstrings(const std::string& first, const std::string& second):
+        suffix_array({first, second}), common(), passed(), count(0) {
+    // LCP с последним встреченным суффиксом каждой строки, 0 - если такого ещё не было
+    const size_t length = suffix_array.Size();
+    common.assign(length, 0);
+    size_t nearest[2] = {0, 0};
+    for (size_t r = 0; r < length; ++r) {
+        nearest[0] = std::min(nearest[0], suffix_array.Lcp(r));
+        nearest[1] = std::min(nearest[1], suffix_array.Lcp(r));
+        const size_t side = suffix_array.Owner(r);
+        common[r] = nearest[side ^ 1];
+        nearest[side] = length;
+    }
+    nearest[0] = nearest[1] = 0;
+    for (size_t r = length; r-- > 0;) {
+        if (r + 1 < length) {
+            nearest[0] = std::min(nearest[0], suffix_array.Lcp(r + 1));
+            nearest[1] = std::min(nearest[1], suffix_array.Lcp(r + 1));
+        }
+        const size_t side = suffix_array.Owner(r);
+        common[r] = std::max<size_t>(common[r], nearest[side ^ 1]);
+        nearest[side] = length;
+    }
+    passed.assign(length + 1, 0);
+    for (size_t r = 0; r < length; ++r) {
+        passed[r + 1] = passed[r] + (common[r] > suffix_array.Lcp(r) ? common[r] - suffix_array.Lcp(r) : 0);
+    }
+    count = passed[length];
+}
+
+template <class Index>
+uint64_t CommonSubstrings<Index>::Count() const {
+    return count;
+}
+
+template <class Index>
+std::optional<std::string> CommonSubstrings<Index>::Kth(uint64_t k) const {
+    if (!k || k > count) {
+        return std::nullopt;
+    }
+    // Первый ранг r, на котором набирается k: passed[r] < k <= passed[r + 1]
+    const size_t r = std::lower_bound(passed.begin() + 1, passed.end(), k) - passed.begin() - 1;
+    return suffix_array.Prefix(r, suffix_array.Lcp(r) + (k - passed[r]));
+}
+
+template <class Index>
+std::vector<std::optional<std::string>> CommonSubstrings<Index>::KthBatch(
+        const std::vector<uint64_t>& k_values) const {
+    std::vector<std::optional<std::string>> result(k_values.size());
+    std::vector<size_t> order;
+    order.reserve(k_values.size());
+    for (size_t i = 0; i < k_values.size(); ++i) {
+        if (k_values[i] && k_values[i] <= count) {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&k_values](size_t lhv, size_t rhv) {
+        return k_values[lhv] < k_values[rhv];
+    });
+
+    // Как в Kth, но поиск начинается с позиции предыдущего k: шаг удваивается, пока passed не наберёт k
+    auto from = passed.begin() + 1;
+    for (size_t query : order) {
+        const uint64_t k = k_values[query];
+        size_t step = 1;
+        while (step < static_cast<size_t>(passed.end() - from) && from[step] < k) {
+            from += step;
+            step *= 2;
+        }
+        const auto to = step < static_cast<size_t>(passed.end() - from) ? from + step + 1 : passed.end();
+        from = std::lower_bound(from, to, k);
+        const size_t r = from - passed.begin() - 1;
+        result[query] = suffix_array.Prefix(r, suffix_array.Lcp(r) + (k - passed[r]));
+    }
+    return result;
+}
+
+#endif //KTHCOMMONSUBSTR_COMMON_SUBSTRINGS_H
@@ -1,6 +1,49 @@
+/*
+ * Description(Russian):
+ * Даны строки s и t и число k. Найти k-ю в лексикографическом порядке
+ * среди различных общих подстрок s и t. Если их меньше k, вывести -1.
+ * После s и t может идти сколько угодно чисел k, ответ на каждое - в своей строке.
+ * Time: O(|s| + |t| + q log(|s| + |t|) + ответ)
+ * Memory: O(|s| + |t|)
+ */
+
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "common_substrings.h"
+
+template <class Index>
+void PrintKth(const std::string& s, const std::string& t, const std::vector<uint64_t>& k_values) {
+    // По одному Kth на запрос: в памяти не больше одного ответа, а ответы бывают длины |s|
+    CommonSubstrings<Index> common(s, t);
+    for (uint64_t k : k_values) {
+        const auto result = common.Kth(k);
+        if (result) {
+            printf("%s\n", result->c_str());
+        } else {
+            printf("-1\n");
+        }
+    }
+}
 
 int main() {
-    std::cout << "Hello, World!" << std::endl;
+    std::ios_base::sync_with_stdio(false);
+    std::string s;
+    std::string t;
+    std::cin >> s >> t;
+    std::vector<uint64_t> k_values;
+    uint64_t k = 0;
+    while (std::cin >> k) {
+        k_values.push_back(k);
+    }
+    if (s.length() + t.length() < std::numeric_limits<uint32_t>::max()) {
+        PrintKth<uint32_t>(s, t, k_values);
+    } else {
+        PrintKth<uint64_t>(s, t, k_values);
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,243 @@
+/*
+ Сравнение KmpMatcher (амортизированный O(1) на символ) и KmpAutomaton (O(1) на каждый символ)
+ на периодических входах, где цепочка границ максимально длинная.
+ Печатает пропускную способность, 99.9-й перцентиль задержки на блок из BLOCK символов
+ и максимальное число переходов по границам на один символ у KMP (у автомата всегда 1).
+ Lz77Cursor по потоку LZ77-троек (только серии - RLE, и серии вперемешку с копиями) против
+ распаковки всего текста и StreamCursor::Feed по нему.
+ RabinKarpSet - 1000 шаблонов длины 32 за один проход против скалярного однополосного Rabin-Karp
+ с std::unordered_multimap; векторная ветка включается флагами сборки, например -march=native.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "index_width.h"
+#include "kmp_automaton.h"
+#include "kmp_matcher.h"
+#include "lz77_cursor.h"
+#include "rabin_karp.h"
+
+const size_t BLOCK = 64;
+const size_t TEXT_LENGTH = 1 << 24;
+
+struct BenchResult {
+    double ns_per_char;
+    double block_p999_ns;
+    size_t matches;
+};
+
+template <class Matcher>
+BenchResult Run(const Matcher& matcher, const std::string& text) {
+    using Clock = std::chrono::steady_clock;
+    auto cursor = matcher.NewCursor();
+    BenchResult result{0, 0, 0};
+    auto on_match = [&result](size_t) { ++result.matches; };
+    std::vector<double> block_times;
+    block_times.reserve(text.length() / BLOCK + 1);
+
+    auto begin = Clock::now();
+    for (size_t offset = 0; offset < text.length(); offset += BLOCK) {
+        auto block_begin = Clock::now();
+        cursor.Feed(std::string_view(text).substr(offset, BLOCK), on_match);
+        std::chrono::duration<double, std::nano> block_time = Clock::now() - block_begin;
+        block_times.push_back(block_time.count());
+    }
+    std::chrono::duration<double, std::nano> total = Clock::now() - begin;
+    result.ns_per_char = total.count() / text.length();
+
+    auto p999 = block_times.begin() + block_times.size() * 999 / 1000;
+    std::nth_element(block_times.begin(), p999, block_times.end());
+    result.block_p999_ns = *p999;
+    return result;
+}
+
+size_t MaxBorderHops(const std::string& pattern, const std::string& text) {
+    auto prefix_function_results = PrefixFunction(pattern);
+    size_t max_hops = 0;
+    size_t state = 0;
+    for (char ch : text) {
+        if (state == pattern.length()) {
+            state = prefix_function_results[state - 1];
+        }
+        size_t hops = 0;
+        while (state > 0 && pattern[state] != ch) {
+            state = prefix_function_results[state - 1];
+            ++hops;
+        }
+        if (pattern[state] == ch) {
+            ++state;
+        }
+        max_hops = std::max(max_hops, hops);
+    }
+    return max_hops;
+}
+
+std::string Repeat(const std::string& period, size_t length) {
+    std::string result;
+    result.reserve(length);
+    while (result.length() < length) {
+        result += period;
+    }
+    result.resize(length);
+    return result;
+}
+
+std::string Fibonacci(size_t length) {
+    std::string prev = "a";
+    std::string current = "ab";
+    while (current.length() < length) {
+        std::string next = current + prev;
+        prev = std::move(current);
+        current = std::move(next);
+    }
+    current.resize(length);
+    return current;
+}
+
+void Report(const char* name, const std::string& pattern, const std::string& text) {
+    auto [kmp, real_time] = DispatchIndexWidth(pattern.length(), [&](auto index_tag) {
+        KmpMatcher<decltype(index_tag)> matcher(pattern);
+        KmpAutomaton<decltype(index_tag)> automaton(pattern);
+        return std::make_pair(Run(matcher, text), Run(automaton, text));
+    });
+    printf("%-24s p=%-6zu kmp: %5.2f ns/char, p99.9 block %7.0f ns, max hops %-6zu | "
+           "automaton: %5.2f ns/char, p99.9 block %7.0f ns | matches %zu%s\n",
+           name, pattern.length(), kmp.ns_per_char, kmp.block_p999_ns, MaxBorderHops(pattern, text),
+           real_time.ns_per_char, real_time.block_p999_ns, kmp.matches,
+           kmp.matches == real_time.matches ? "" : " MISMATCH");
+}
+
+template <class Function>
+double Milliseconds(Function&& function) {
+    auto begin = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - begin;
+    return time.count();
+}
+
+size_t ScalarRabinKarpCount(const std::vector<std::string>& patterns, const std::string& text) {
+    const uint32_t BASE = 0x01000193;
+    const size_t length = patterns[0].length();
+    auto hash = [&](const char* str) {
+        uint32_t value = 0;
+        for (size_t i = 0; i < length; ++i) {
+            value = value * BASE + static_cast<unsigned char>(str[i]);
+        }
+        return value;
+    };
+    uint32_t power = 1;
+    for (size_t i = 0; i < length; ++i) {
+        power *= BASE;
+    }
+    std::unordered_multimap<uint32_t, size_t> table;
+    for (size_t idx = 0; idx < patterns.size(); ++idx) {
+        table.emplace(hash(patterns[idx].data()), idx);
+    }
+    size_t matches = 0;
+    uint32_t value = hash(text.data());
+    for (size_t i = 0; i + length <= text.length(); ++i) {
+        auto [begin, end] = table.equal_range(value);
+        for (; begin != end; ++begin) {
+            matches += !memcmp(text.data() + i, patterns[begin->second].data(), length);
+        }
+        if (i + length < text.length()) {
+            value = value * BASE - static_cast<unsigned char>(text[i]) * power +
+                    static_cast<unsigned char>(text[i + length]);
+        }
+    }
+    return matches;
+}
+
+// Тройки LZ77 на text_length символов: серии длины до 2000 и, если copies, копии с отступом до window
+std::vector<Lz77Token> RandomLz77(size_t text_length, size_t window, bool copies) {
+    std::mt19937 generator(3);
+    std::vector<Lz77Token> tokens;
+    size_t position = 0;
+    while (position < text_length) {
+        Lz77Token token{0, 0, static_cast<char>('a' + generator() % 2)};
+        if (position && (!copies || generator() % 2)) {
+            token.distance = 1;
+            token.length = 1 + generator() % 2000;
+        } else if (position > 1) {
+            token.distance = 2 + generator() % (std::min(position, window) - 1);
+            token.length = 1 + generator() % 200;
+        }
+        tokens.push_back(token);
+        position += token.length + 1;
+    }
+    return tokens;
+}
+
+void ReportLz77(const char* name, const std::string& pattern, const std::vector<Lz77Token>& tokens, size_t window) {
+    KmpMatcher<uint32_t> matcher(pattern);
+    size_t expanded_matches = 0;
+    size_t text_length = 0;
+    double expanded_time = Milliseconds([&] {
+        std::string text;
+        for (const auto& token : tokens) {
+            for (size_t i = 0; i < token.length; ++i) {
+                text.push_back(text[text.length() - token.distance]);
+            }
+            text.push_back(token.literal);
+        }
+        text_length = text.length();
+        auto cursor = matcher.NewCursor();
+        cursor.Feed(text, [&expanded_matches](size_t) { ++expanded_matches; });
+    });
+    size_t matches = 0;
+    double time = Milliseconds([&] {
+        Lz77Cursor<KmpMatcher<uint32_t>> cursor(matcher, window);
+        for (const auto& token : tokens) {
+            cursor.Feed(token, [&matches](size_t) { ++matches; });
+        }
+    });
+    printf("%-10s %zu tokens, %zu chars: decompress + feed %7.1f ms | lz77 cursor %7.1f ms | matches %zu%s\n",
+           name, tokens.size(), text_length, expanded_time, time, matches,
+           matches == expanded_matches ? "" : " MISMATCH");
+}
+
+void ReportRabinKarp(size_t patterns_count, size_t pattern_length) {
+    std::mt19937 generator(1);
+    std::string text(TEXT_LENGTH, 'a');
+    for (auto& ch : text) {
+        ch = static_cast<char>('a' + generator() % 4);
+    }
+    std::vector<std::string> patterns(patterns_count);
+    for (auto& pattern : patterns) {
+        pattern = text.substr(generator() % (TEXT_LENGTH - pattern_length), pattern_length);
+    }
+    size_t scalar_matches = 0;
+    double scalar_time = Milliseconds([&] { scalar_matches = ScalarRabinKarpCount(patterns, text); });
+    size_t matches = 0;
+    double time = Milliseconds([&] {
+        RabinKarpSet rabin_karp(patterns);
+        rabin_karp.Search(text, [&matches](uint32_t, size_t) { ++matches; });
+    });
+    printf("rabin-karp k=%zu m=%zu: scalar %5.2f ns/char | lanes %5.2f ns/char | matches %zu%s\n",
+           patterns_count, pattern_length, scalar_time * 1e6 / TEXT_LENGTH, time * 1e6 / TEXT_LENGTH, matches,
+           matches == scalar_matches ? "" : " MISMATCH");
+}
+
+int main() {
+    for (size_t p : {64, 4096, 30000}) {
+        // a^{p-1}b против (a^{p-1}c)*: на каждом 'c' KMP проходит всю цепочку границ
+        std::string pattern = std::string(p - 1, 'a') + 'b';
+        Report("a^(p-1)b / (a^(p-1)c)*", pattern, Repeat(std::string(p - 1, 'a') + 'c', TEXT_LENGTH));
+        Report("fibonacci", Fibonacci(p), Fibonacci(TEXT_LENGTH));
+    }
+    const std::string run_pattern = std::string(16, 'a') + 'b';
+    ReportLz77("rle", run_pattern, RandomLz77(TEXT_LENGTH, 1 << 16, false), 1 << 16);
+    ReportLz77("lz77", run_pattern, RandomLz77(TEXT_LENGTH, 1 << 16, true), 1 << 16);
+    ReportRabinKarp(1000, 32);
+    return 0;
+}
@@ -0,0 +1,24 @@
+#ifndef SUBSTRING_INDEX_WIDTH_H
+#define SUBSTRING_INDEX_WIDTH_H
+
+#include <cstdint>
+#include <limits>
+
+/*
+ Вызывает visitor(Index{}) с самым узким из uint16_t, uint32_t, uint64_t,
+ в который помещаются значения 0..max_value.
+ Для шаблона p <= 30000 таблица префикс-функции занимает 2 байта на символ вместо 8.
+ Общий модуль: Z-Prefix-String подключает его через include_directories(../Substring).
+ */
+template <class Visitor>
+decltype(auto) DispatchIndexWidth(size_t max_value, Visitor&& visitor) {
+    if (max_value <= std::numeric_limits<uint16_t>::max()) {
+        return visitor(uint16_t{});
+    }
+    if (max_value <= std::numeric_limits<uint32_t>::max()) {
+        return visitor(uint32_t{});
+    }
+    return visitor(uint64_t{});
+}
+
+#endif //SUBSTRING_INDEX_WIDTH_H
@@ -0,0 +1,85 @@
+#ifndef SUBSTRING_KMP_AUTOMATON_H
+#define SUBSTRING_KMP_AUTOMATON_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "kmp_matcher.h"
+
+/*
+ Real-time вариант KmpMatcher: полный автомат переходов без суффиксных ссылок,
+ ровно одно обращение к таблице на символ потока.
+ Алфавит сжимается до символов шаблона плюс класс "любой другой",
+ поэтому таблица занимает (p + 1) * (sigma + 1) ячеек, sigma - число различных символов шаблона.
+ Время построения: O(p * sigma)
+ Память: O(p * sigma)
+ */
+template <class Index = size_t>
+class KmpAutomaton {
+public:
+    using Cursor = StreamCursor<KmpAutomaton>;
+
+    explicit KmpAutomaton(const std::string& pattern);
+
+    Cursor NewCursor() const;
+
+    size_t PatternLength() const;
+
+    size_t Step(size_t state, char ch) const;
+
+    ~KmpAutomaton() = default;
+
+private:
+    size_t pattern_length;
+    size_t classes_count;
+    std::array<uint16_t, 256> char_class;
+    std::vector<Index> transitions;  // transitions[state * classes_count + class]
+};
+
+template <class Index>
+KmpAutomaton<Index>::KmpAutomaton(const std::string& pattern): pattern_length(pattern.length()),
+        classes_count(1), char_class(), transitions() {
+    for (char ch : pattern) {
+        auto& ch_class = char_class[static_cast<unsigned char>(ch)];
+        if (!ch_class) {
+            ch_class = classes_count++;  // Класс 0 - символы, которых нет в шаблоне
+        }
+    }
+
+    auto prefix_function_results = PrefixFunction<Index>(pattern);
+    transitions.assign((pattern_length + 1) * classes_count, 0);
+    if (pattern_length == 0) {
+        return;
+    }
+    transitions[char_class[static_cast<unsigned char>(pattern[0])]] = 1;
+    for (size_t state = 1; state <= pattern_length; ++state) {
+        const size_t border = prefix_function_results[state - 1];
+        for (size_t ch_class = 0; ch_class < classes_count; ++ch_class) {
+            transitions[state * classes_count + ch_class] =
+                    transitions[border * classes_count + ch_class];
+        }
+        if (state < pattern_length) {
+            transitions[state * classes_count +
+                        char_class[static_cast<unsigned char>(pattern[state])]] = state + 1;
+        }
+    }
+}
+
+template <class Index>
+typename KmpAutomaton<Index>::Cursor KmpAutomaton<Index>::NewCursor() const {
+    return Cursor(*this);
+}
+
+template <class Index>
+size_t KmpAutomaton<Index>::PatternLength() const {
+    return pattern_length;
+}
+
+template <class Index>
+size_t KmpAutomaton<Index>::Step(size_t state, char ch) const {
+    return transitions[state * classes_count + char_class[static_cast<unsigned char>(ch)]];
+}
+
+#endif //SUBSTRING_KMP_AUTOMATON_H
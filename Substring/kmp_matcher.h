@@ -0,0 +1,199 @@
+#ifndef SUBSTRING_KMP_MATCHER_H
+#define SUBSTRING_KMP_MATCHER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Index - тип ячейки таблицы, должен вмещать длину шаблона (см. DispatchIndexWidth)
+template <class Index>
+size_t PrefixFunction(const std::string& pattern_with_symbol, char current_char,
+                      const std::vector<Index>& prefix_function_results, size_t prev_value);
+
+template <class Index = size_t>
+std::vector<Index> PrefixFunction(const std::string& text);
+
+/*
+ Курсор одного потока текста поверх неизменяемого matcher-а:
+ указатель на matcher, длина текущего совпадения и позиция в потоке.
+ Matcher должен предоставлять Step(state, ch) и PatternLength().
+ */
+template <class Matcher>
+class StreamCursor {
+public:
+    explicit StreamCursor(const Matcher& matcher);
+
+    // on_match(idx) вызывается для начала каждого вхождения, idx - позиция в потоке
+    template <class Callback>
+    void Feed(std::string_view chunk, Callback&& on_match);
+
+    std::vector<size_t> Feed(std::string_view chunk);
+
+    // count одинаковых символов ch, например серия из RLE-потока.
+    // Не более p + 2 шагов автомата: дальше состояние неподвижно, и серия проматывается целиком
+    template <class Callback>
+    void FeedRun(char ch, size_t count, Callback&& on_match);
+
+    size_t Position() const;
+    void Reset();
+
+    ~StreamCursor() = default;
+
+private:
+    const Matcher* matcher;
+    size_t state;
+    size_t position;
+};
+
+/*
+ Префикс-функция шаблона считается один раз и разделяется между потоками.
+ Matcher неизменяем после построения, так что курсоры можно вести из разных нитей.
+ Шаг амортизированно O(1), но на одном символе может быть до O(p) переходов по границам.
+ */
+template <class Index = size_t>
+class KmpMatcher {
+public:
+    using Cursor = StreamCursor<KmpMatcher>;
+
+    explicit KmpMatcher(const std::string& pattern);
+
+    Cursor NewCursor() const;
+
+    size_t PatternLength() const;
+
+    size_t Step(size_t state, char ch) const;
+
+    ~KmpMatcher() = default;
+
+private:
+    std::string pattern;
+    std::vector<Index> prefix_function_results;
+};
+
+template <class Index>
+KmpMatcher<Index>::KmpMatcher(const std::string& pattern): pattern(pattern),
+        prefix_function_results(PrefixFunction<Index>(pattern)) {}
+
+template <class Index>
+typename KmpMatcher<Index>::Cursor KmpMatcher<Index>::NewCursor() const {
+    return Cursor(*this);
+}
+
+template <class Index>
+size_t KmpMatcher<Index>::PatternLength() const {
+    return pattern.length();
+}
+
+template <class Index>
+size_t KmpMatcher<Index>::Step(size_t state, char ch) const {
+    if (state == pattern.length()) {  // После полного совпадения откатываемся по границе
+        state = prefix_function_results[state - 1];
+    }
+    return PrefixFunction(pattern, ch, prefix_function_results, state);
+}
+
+template <class Matcher>
+StreamCursor<Matcher>::StreamCursor(const Matcher& matcher): matcher(&matcher),
+        state(0), position(0) {}
+
+template <class Matcher>
+template <class Callback>
+void StreamCursor<Matcher>::Feed(std::string_view chunk, Callback&& on_match) {
+    const size_t pattern_length = matcher->PatternLength();
+    if (pattern_length == 0) {
+        position += chunk.size();
+        return;
+    }
+    for (char ch : chunk) {
+        state = matcher->Step(state, ch);
+        ++position;
+        if (state == pattern_length) {
+            on_match(position - pattern_length);
+        }
+    }
+}
+
+template <class Matcher>
+std::vector<size_t> StreamCursor<Matcher>::Feed(std::string_view chunk) {
+    std::vector<size_t> occurrence_idxes;
+    Feed(chunk, [&occurrence_idxes](size_t idx) {
+        occurrence_idxes.push_back(idx);
+    });
+    return occurrence_idxes;
+}
+
+template <class Matcher>
+template <class Callback>
+void StreamCursor<Matcher>::FeedRun(char ch, size_t count, Callback&& on_match) {
+    const size_t pattern_length = matcher->PatternLength();
+    if (pattern_length == 0) {
+        position += count;
+        return;
+    }
+    while (count) {
+        const size_t prev_state = state;
+        state = matcher->Step(state, ch);
+        ++position;
+        --count;
+        if (state == pattern_length) {
+            on_match(position - pattern_length);
+        }
+        if (state == prev_state) {  // Неподвижная точка: шаблон ch^p совпадает на каждом символе, иначе - нигде
+            if (state == pattern_length) {
+                for (size_t i = 1; i <= count; ++i) {
+                    on_match(position + i - pattern_length);
+                }
+            }
+            position += count;
+            return;
+        }
+    }
+}
+
+template <class Matcher>
+size_t StreamCursor<Matcher>::Position() const {
+    return position;
+}
+
+template <class Matcher>
+void StreamCursor<Matcher>::Reset() {
+    state = 0;
+    position = 0;
+}
+
+template <class Index>
+size_t PrefixFunction(const std::string& pattern_with_symbol, char current_char,
+        const std::vector<Index>& prefix_function_results, size_t prev_value) {  // Преф. функция текста
+    auto prefix_length = prev_value;
+    while (prefix_length > 0 && current_char !=
+        pattern_with_symbol[prefix_length]) {
+        prefix_length = prefix_function_results[prefix_length - 1];
+    }
+    if (pattern_with_symbol[prefix_length] == current_char) {
+        return ++prefix_length;
+    }
+    return prefix_length;
+}
+
+template <class Index>
+std::vector<Index> PrefixFunction(const std::string& text) {  // O(n), для обработки паттерна
+    std::vector<Index> prefix_function_result(text.size());
+    if (text.empty()) {
+        return prefix_function_result;
+    }
+    prefix_function_result[0] = 0;
+    size_t prefix_length;
+    for (size_t i = 1; i < text.length(); ++i) {
+        prefix_length = prefix_function_result[i - 1];
+        while (prefix_length > 0 && text[i] != text[prefix_length]) {
+            prefix_length = prefix_function_result[prefix_length - 1];
+        }
+        if (text[i] == text[prefix_length]) {
+            ++prefix_length;
+        }
+        prefix_function_result[i] = prefix_length;
+    }
+    return prefix_function_result;
+}
+
+#endif //SUBSTRING_KMP_MATCHER_H
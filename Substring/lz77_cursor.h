@@ -0,0 +1,113 @@
+#ifndef SUBSTRING_LZ77_CURSOR_H
+#define SUBSTRING_LZ77_CURSOR_H
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+#include "kmp_matcher.h"
+
+// Классическая тройка LZ77: скопировать length символов с отступом distance назад, затем literal
+struct Lz77Token {
+    size_t distance;
+    size_t length;
+    char literal;
+};
+
+/*
+ Поиск шаблона по LZ77-потоку без распаковки всего текста:
+ в памяти только кольцевой буфер на 2 * window последних символов.
+ Копии с distance == 1 - это серии одного символа, они идут через StreamCursor::FeedRun
+ и проматываются за O(p) независимо от длины.
+ Остальные копии разворачиваются в буфер блоками не длиннее window и сразу скармливаются курсору.
+ Память: O(p + window)
+ */
+template <class Matcher>
+class Lz77Cursor {
+public:
+    Lz77Cursor(const Matcher& matcher, size_t window);
+
+    // distance должен быть не больше window и не больше числа уже прочитанных символов
+    template <class Callback>
+    void Feed(const Lz77Token& token, Callback&& on_match);
+
+    size_t Position() const;
+
+    ~Lz77Cursor() = default;
+
+private:
+    template <class Callback>
+    void Copy(size_t distance, size_t length, Callback&& on_match);
+
+    template <class Callback>
+    void FeedBuffer(size_t from, size_t length, Callback&& on_match);
+
+    StreamCursor<Matcher> cursor;
+    size_t window;
+    size_t mask;
+    std::vector<char> buffer;
+};
+
+template <class Matcher>
+Lz77Cursor<Matcher>::Lz77Cursor(const Matcher& matcher, size_t window): cursor(matcher),
+        window(window), mask(0), buffer() {
+    size_t buffer_size = 1;
+    while (buffer_size < 2 * window) {
+        buffer_size <<= 1;
+    }
+    buffer.resize(buffer_size);
+    mask = buffer_size - 1;
+}
+
+template <class Matcher>
+template <class Callback>
+void Lz77Cursor<Matcher>::Feed(const Lz77Token& token, Callback&& on_match) {
+    if (token.length) {
+        Copy(token.distance, token.length, on_match);
+    }
+    buffer[cursor.Position() & mask] = token.literal;
+    cursor.Feed(std::string_view(&token.literal, 1), on_match);
+}
+
+template <class Matcher>
+size_t Lz77Cursor<Matcher>::Position() const {
+    return cursor.Position();
+}
+
+template <class Matcher>
+template <class Callback>
+void Lz77Cursor<Matcher>::Copy(size_t distance, size_t length, Callback&& on_match) {
+    if (distance == 1) {
+        const char ch = buffer[(cursor.Position() - 1) & mask];
+        const size_t run_start = cursor.Position();
+        cursor.FeedRun(ch, length, on_match);
+        // В буфере достаточно последних window символов серии
+        for (size_t i = (length > window ? length - window : 0); i < length; ++i) {
+            buffer[(run_start + i) & mask] = ch;
+        }
+        return;
+    }
+    while (length) {
+        // Блок не длиннее window не затирает источники ещё не скопированных символов
+        const size_t block = std::min(length, window);
+        const size_t from = cursor.Position();
+        for (size_t i = 0; i < block; ++i) {
+            buffer[(from + i) & mask] = buffer[(from + i - distance) & mask];
+        }
+        FeedBuffer(from, block, on_match);
+        length -= block;
+    }
+}
+
+template <class Matcher>
+template <class Callback>
+void Lz77Cursor<Matcher>::FeedBuffer(size_t from, size_t length, Callback&& on_match) {
+    const size_t begin = from & mask;
+    const size_t first_part = std::min(length, buffer.size() - begin);
+    cursor.Feed(std::string_view(buffer.data() + begin, first_part), on_match);
+    if (first_part < length) {
+        cursor.Feed(std::string_view(buffer.data(), length - first_part), on_match);
+    }
+}
+
+#endif //SUBSTRING_LZ77_CURSOR_H
@@ -7,74 +7,48 @@
  Memory O(|pattern|)
  */
 
+#include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <string>
-#include <vector>
 
-std::vector<size_t> OnlineOccurrenceIdx(const std::string& pattern_with_symbol);
+#include "index_width.h"
+#include "kmp_matcher.h"
+#include "match_sink.h"
 
-size_t PrefixFunction(const std::string& pattern_with_symbol, char current_char,
-                      const std::vector<size_t>& prefix_function_results, size_t prev_value);
+// sink(idx) получает позиции вхождений по возрастанию, см. match_sink.h
+template <class Sink>
+void OnlineOccurrenceIdx(const std::string& pattern_with_symbol, Sink& sink);
 
-std::vector<size_t> PrefixFunction(const std::string& text);
-
-int main() {
+// Без аргументов - десятичный вывод, "--varint" и "--bitmap" - двоичные форматы из match_sink.h
+int main(int argc, char** argv) {
     std::string pattern;
 
     std::cin >> pattern;
-    auto result = OnlineOccurrenceIdx(pattern);
-    for (const auto& idx : result){
-        std::cout << idx << " ";
+    if (argc > 1 && !strcmp(argv[1], "--varint")) {
+        DeltaVarintSink sink;
+        OnlineOccurrenceIdx(pattern, sink);
+        sink.WriteTo(stdout);
+    } else if (argc > 1 && !strcmp(argv[1], "--bitmap")) {
+        BitmapSink sink;
+        OnlineOccurrenceIdx(pattern, sink);
+        sink.WriteTo(stdout);
+    } else {
+        DecimalSink sink(stdout);
+        OnlineOccurrenceIdx(pattern, sink);
     }
     return 0;
 }
 
-std::vector<size_t> OnlineOccurrenceIdx(const std::string& pattern) {
-    char in_char;
-    auto prefix_function_results = PrefixFunction(pattern);
-    std::vector<size_t> occurrence_idxes;
+template <class Sink>
+void OnlineOccurrenceIdx(const std::string& pattern, Sink& sink) {
+    DispatchIndexWidth(pattern.length(), [&pattern, &sink](auto index_tag) {
+        char in_char;
+        KmpMatcher<decltype(index_tag)> matcher(pattern);
+        auto cursor = matcher.NewCursor();
 
-    size_t prev_value = 0;
-    size_t counter = pattern.length();
-    while (std::cin >> in_char) {
-        prev_value = PrefixFunction(pattern,
-                                    in_char,
-                                    prefix_function_results, prev_value);
-        if (prev_value ==
-                pattern.length()) {
-            occurrence_idxes.push_back(counter - 2 * pattern.length() + 1);
+        while (std::cin >> in_char) {
+            cursor.Feed(std::string_view(&in_char, 1), sink);
         }
-        ++counter;
-    }
-    return occurrence_idxes;
-}
-
-size_t PrefixFunction(const std::string& pattern_with_symbol, char current_char,
-        const std::vector<size_t>& prefix_function_results, size_t prev_value) {  // Преф. функция текста
-    auto prefix_length = prev_value;
-    while (prefix_length > 0 && current_char !=
-        pattern_with_symbol[prefix_length]) {
-        prefix_length = prefix_function_results[prefix_length - 1];
-    }
-    if (pattern_with_symbol[prefix_length] == current_char) {
-        return ++prefix_length;
-    }
-    return prefix_length;
-}
-
-std::vector<size_t> PrefixFunction(const std::string& text) {  // O(n), для обработки паттерна
-    std::vector<size_t> prefix_function_result(text.size());
-    prefix_function_result[0] = 0;
-    int prefix_length;
-    for (size_t i = 1; i < text.length(); ++i) {
-        prefix_length = prefix_function_result[i - 1];
-        while (prefix_length > 0 && text[i] != text[prefix_length]) {
-            prefix_length = prefix_function_result[prefix_length - 1];
-        }
-        if (text[i] == text[prefix_length]) {
-            ++prefix_length;
-        }
-        prefix_function_result[i] = prefix_length;
-    }
-    return prefix_function_result;
+    });
 }
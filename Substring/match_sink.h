@@ -0,0 +1,160 @@
+#ifndef SUBSTRING_MATCH_SINK_H
+#define SUBSTRING_MATCH_SINK_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/*
+ Приёмники позиций вхождений. Позиции приходят строго по возрастанию,
+ каждый приёмник вызывается как sink(idx) и подходит как callback для StreamCursor::Feed.
+ */
+
+// Десятичный текст "idx " через собственный буфер, без iostream
+class DecimalSink {
+public:
+    explicit DecimalSink(FILE* out);
+    void operator()(size_t idx);
+    void Flush();
+    ~DecimalSink();
+
+private:
+    static const size_t BUFFER_SIZE = 1 << 16;
+    static const size_t MAX_RECORD = 21;  // 20 цифр size_t и пробел
+
+    FILE* out;
+    std::vector<char> buffer;
+    size_t used;
+};
+
+// Разности соседних позиций в LEB128: на периодических входах 1 байт на вхождение
+class DeltaVarintSink {
+public:
+    DeltaVarintSink();
+    void operator()(size_t idx);
+    const std::vector<uint8_t>& Data() const;
+    void WriteTo(FILE* out) const;
+    ~DeltaVarintSink() = default;
+
+private:
+    std::vector<uint8_t> data;
+    size_t previous;
+};
+
+std::vector<size_t> DecodeDeltaVarint(const std::vector<uint8_t>& data);
+
+// Бит на каждую позицию текста: выгоднее varint, когда вхождения плотнее одного на 8 символов
+class BitmapSink {
+public:
+    BitmapSink();
+    void operator()(size_t idx);
+    const std::vector<uint64_t>& Words() const;
+    size_t Count() const;
+    void WriteTo(FILE* out) const;
+    ~BitmapSink() = default;
+
+private:
+    std::vector<uint64_t> words;
+    size_t count;
+};
+
+std::vector<size_t> DecodeBitmap(const std::vector<uint64_t>& words);
+
+inline DecimalSink::DecimalSink(FILE* out): out(out), buffer(BUFFER_SIZE), used(0) {}
+
+inline void DecimalSink::operator()(size_t idx) {
+    if (used + MAX_RECORD > buffer.size()) {
+        Flush();
+    }
+    char digits[20];
+    size_t length = 0;
+    do {
+        digits[length++] = static_cast<char>('0' + idx % 10);
+        idx /= 10;
+    } while (idx);
+    while (length) {
+        buffer[used++] = digits[--length];
+    }
+    buffer[used++] = ' ';
+}
+
+inline void DecimalSink::Flush() {
+    fwrite(buffer.data(), 1, used, out);
+    used = 0;
+}
+
+inline DecimalSink::~DecimalSink() {
+    Flush();
+}
+
+inline DeltaVarintSink::DeltaVarintSink(): data(), previous(0) {}
+
+inline void DeltaVarintSink::operator()(size_t idx) {
+    size_t delta = idx - previous;
+    previous = idx;
+    while (delta >= 0x80) {
+        data.push_back(static_cast<uint8_t>(delta | 0x80));
+        delta >>= 7;
+    }
+    data.push_back(static_cast<uint8_t>(delta));
+}
+
+inline const std::vector<uint8_t>& DeltaVarintSink::Data() const {
+    return data;
+}
+
+inline void DeltaVarintSink::WriteTo(FILE* out) const {
+    fwrite(data.data(), 1, data.size(), out);
+}
+
+inline std::vector<size_t> DecodeDeltaVarint(const std::vector<uint8_t>& data) {
+    std::vector<size_t> idxes;
+    size_t previous = 0;
+    size_t delta = 0;
+    size_t shift = 0;
+    for (uint8_t byte : data) {
+        delta |= static_cast<size_t>(byte & 0x7f) << shift;
+        shift += 7;
+        if (!(byte & 0x80)) {
+            previous += delta;
+            idxes.push_back(previous);
+            delta = 0;
+            shift = 0;
+        }
+    }
+    return idxes;
+}
+
+inline BitmapSink::BitmapSink(): words(), count(0) {}
+
+inline void BitmapSink::operator()(size_t idx) {
+    if (idx / 64 >= words.size()) {
+        words.resize(idx / 64 + 1);
+    }
+    words[idx / 64] |= uint64_t(1) << (idx % 64);
+    ++count;
+}
+
+inline const std::vector<uint64_t>& BitmapSink::Words() const {
+    return words;
+}
+
+inline size_t BitmapSink::Count() const {
+    return count;
+}
+
+inline void BitmapSink::WriteTo(FILE* out) const {
+    fwrite(words.data(), sizeof(uint64_t), words.size(), out);
+}
+
+inline std::vector<size_t> DecodeBitmap(const std::vector<uint64_t>& words) {
+    std::vector<size_t> idxes;
+    for (size_t i = 0; i < words.size(); ++i) {
+        for (uint64_t word = words[i]; word; word &= word - 1) {
+            idxes.push_back(i * 64 + __builtin_ctzll(word));
+        }
+    }
+    return idxes;
+}
+
+#endif //SUBSTRING_MATCH_SINK_H
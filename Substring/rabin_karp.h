@@ -0,0 +1,261 @@
+#ifndef SUBSTRING_RABIN_KARP_H
+#define SUBSTRING_RABIN_KARP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/*
+ Rabin-Karp сразу для множества шаблонов одной длины m: один проход по тексту на весь набор.
+ Полиномиальный хэш по модулю 2^32, отпечатки шаблонов лежат в открытой хэш-таблице,
+ каждое совпадение отпечатка проверяется memcmp, так что коллизии стоят только времени.
+ Перед таблицей - битовый фильтр по старшим битам хэша (не меньше 32 бит на шаблон):
+ почти все окна отсекаются одной загрузкой без ветвлений по цепочке таблицы.
+ Текст идёт сегментами, сегмент режется на LANES = 8 полос подряд, их хэши катятся одновременно:
+ восемь 32-битных умножений за шаг (AVX2 _mm256_mullo_epi32, SSE2 - две половины по 4,
+ что доступно при сборке; иначе скалярный цикл по полосам).
+ Хэши сегмента складываются в буфер и проверяются по возрастанию позиции, так что вхождения
+ отдаются по порядку сразу после сегмента, а память не зависит от числа вхождений.
+ Полоса не короче 4m: начальные хэши полос в каждом сегменте - не больше четверти символа на позицию.
+ Время: O(n + k * m + Z * m), k - число шаблонов, Z - число совпадений отпечатков
+ Память: O(k * m + LANES * max(4096, 4m) + 2^16)
+ */
+class RabinKarpSet {
+public:
+    explicit RabinKarpSet(const std::vector<std::string>& patterns);
+
+    // on_match(pattern_idx, idx) по возрастанию idx; одинаковые шаблоны сообщаются каждый отдельно
+    template <class Callback>
+    void Search(std::string_view text, Callback&& on_match) const;
+
+    size_t PatternLength() const;
+
+    ~RabinKarpSet() = default;
+
+private:
+    static constexpr size_t LANES = 8;
+    static constexpr size_t MIN_LANE_LENGTH = 4096;
+    static constexpr uint32_t BASE = 0x01000193;
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    uint32_t Hash(const char* str) const;
+
+    // Старшие биты хэша, умноженного на 2^32 / phi: младшие биты полиномиального хэша перемешаны плохо
+    size_t Slot(uint32_t hash) const;
+
+    // Хэши окон start[lane] + step для step < steps в hashes[step * LANES + lane]
+    void HashLanes(std::string_view text, const size_t* start, size_t steps, uint32_t* hashes) const;
+
+    template <class Callback>
+    void Probe(std::string_view text, size_t idx, uint32_t hash, Callback&& on_match) const;
+
+    size_t pattern_length;
+    uint32_t base_power;  // BASE^m
+    std::string pattern_data;  // Шаблоны подряд, шаблон i начинается с i * m
+    std::vector<uint32_t> slot_hash;
+    std::vector<uint32_t> slot_pattern;
+    size_t mask;
+    size_t shift;
+    std::vector<uint64_t> filter;
+    size_t filter_shift;
+};
+
+inline RabinKarpSet::RabinKarpSet(const std::vector<std::string>& patterns):
+        pattern_length(patterns.empty() ? 0 : patterns[0].length()), base_power(1),
+        pattern_data(), slot_hash(), slot_pattern(), mask(0), shift(32), filter(), filter_shift(32) {
+    if (pattern_length == 0) {
+        throw std::invalid_argument("RabinKarpSet: patterns must be non-empty");
+    }
+    for (size_t i = 0; i < pattern_length; ++i) {
+        base_power *= BASE;
+    }
+
+    size_t table_size = 2;
+    while (table_size < 2 * patterns.size()) {  // Заполненность не больше половины
+        table_size <<= 1;
+    }
+    mask = table_size - 1;
+    while ((size_t(1) << (32 - shift)) < table_size) {
+        --shift;
+    }
+    size_t filter_size = 1 << 16;
+    while (filter_size < 32 * patterns.size()) {
+        filter_size <<= 1;
+    }
+    while ((size_t(1) << (32 - filter_shift)) < filter_size) {
+        --filter_shift;
+    }
+    filter.assign(filter_size / 64, 0);
+    slot_hash.assign(table_size, 0);
+    slot_pattern.assign(table_size, EMPTY);
+    pattern_data.reserve(patterns.size() * pattern_length);
+
+    for (uint32_t idx = 0; idx < patterns.size(); ++idx) {
+        if (patterns[idx].length() != pattern_length) {
+            throw std::invalid_argument("RabinKarpSet: patterns must have equal length");
+        }
+        pattern_data += patterns[idx];
+        const uint32_t hash = Hash(patterns[idx].data());
+        size_t slot = Slot(hash);
+        while (slot_pattern[slot] != EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        filter[(hash >> filter_shift) / 64] |= uint64_t(1) << ((hash >> filter_shift) % 64);
+        slot_hash[slot] = hash;
+        slot_pattern[slot] = idx;
+    }
+}
+
+inline size_t RabinKarpSet::PatternLength() const {
+    return pattern_length;
+}
+
+inline uint32_t RabinKarpSet::Hash(const char* str) const {
+    uint32_t hash = 0;
+    for (size_t i = 0; i < pattern_length; ++i) {
+        hash = hash * BASE + static_cast<unsigned char>(str[i]);
+    }
+    return hash;
+}
+
+inline size_t RabinKarpSet::Slot(uint32_t hash) const {
+    return static_cast<uint32_t>(hash * 0x9e3779b9u) >> shift;
+}
+
+#if defined(__SSE2__) && !defined(__AVX2__)
+// Младшие 32 бита попарных произведений: в SSE2 нет _mm_mullo_epi32, чётные и нечётные полосы отдельно
+inline __m128i MultiplyLow32(__m128i lhv, __m128i rhv) {
+    const __m128i even = _mm_mul_epu32(lhv, rhv);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(lhv, 32), _mm_srli_epi64(rhv, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
+inline void RabinKarpSet::HashLanes(std::string_view text, const size_t* start, size_t steps,
+                                    uint32_t* hashes) const {
+    uint32_t lane_hash[LANES];
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        lane_hash[lane] = start[lane] + pattern_length <= text.length() ? Hash(text.data() + start[lane]) : 0;
+    }
+    // Уходящий и приходящий символы каждой полосы; за пределами текста катим нулями,
+    // такие хэши лежат за концом сегмента и не проверяются
+    uint32_t out[LANES];
+    uint32_t in[LANES];
+    auto load = [&](size_t step) {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            const size_t idx = start[lane] + step;
+            out[lane] = idx < text.length() ? static_cast<unsigned char>(text[idx]) : 0;
+            in[lane] = idx + pattern_length < text.length() ?
+                    static_cast<unsigned char>(text[idx + pattern_length]) : 0;
+        }
+    };
+#if defined(__AVX2__)
+    const __m256i base = _mm256_set1_epi32(BASE);
+    const __m256i power = _mm256_set1_epi32(base_power);
+    const __m256i low_byte = _mm256_set1_epi32(0xff);
+    __m256i hash = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lane_hash));
+    // Символы полос собираются gather по 4 байта от start[0], пока все 4 байта внутри текста
+    const size_t last_start = start[LANES - 1];
+    const size_t gather_steps = last_start + pattern_length + 4 <= text.length() ?
+            std::min(steps, text.length() - last_start - pattern_length - 3) : 0;
+    int32_t offsets[LANES];
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        offsets[lane] = start[lane] - start[0];
+    }
+    __m256i offset = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets));
+    const int* out_base = reinterpret_cast<const int*>(text.data() + start[0]);
+    const int* in_base = reinterpret_cast<const int*>(text.data() + start[0] + pattern_length);
+    for (size_t step = 0; step < steps; ++step) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(hashes + step * LANES), hash);
+        __m256i out_vector;
+        __m256i in_vector;
+        if (step < gather_steps) {
+            out_vector = _mm256_and_si256(_mm256_i32gather_epi32(out_base, offset, 1), low_byte);
+            in_vector = _mm256_and_si256(_mm256_i32gather_epi32(in_base, offset, 1), low_byte);
+            offset = _mm256_add_epi32(offset, _mm256_set1_epi32(1));
+        } else {
+            load(step);
+            out_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(out));
+            in_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        }
+        hash = _mm256_add_epi32(_mm256_sub_epi32(_mm256_mullo_epi32(hash, base),
+                                                 _mm256_mullo_epi32(out_vector, power)), in_vector);
+    }
+#elif defined(__SSE2__)
+    const __m128i base = _mm_set1_epi32(BASE);
+    const __m128i power = _mm_set1_epi32(base_power);
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane_hash));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lane_hash + 4));
+    for (size_t step = 0; step < steps; ++step) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hashes + step * LANES), low);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hashes + step * LANES + 4), high);
+        load(step);
+        low = _mm_add_epi32(_mm_sub_epi32(MultiplyLow32(low, base),
+                                          MultiplyLow32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(out)), power)),
+                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+        high = _mm_add_epi32(_mm_sub_epi32(MultiplyLow32(high, base),
+                                           MultiplyLow32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(out + 4)),
+                                                         power)),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 4)));
+    }
+#else
+    for (size_t step = 0; step < steps; ++step) {
+        load(step);
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            hashes[step * LANES + lane] = lane_hash[lane];
+            lane_hash[lane] = lane_hash[lane] * BASE - out[lane] * base_power + in[lane];
+        }
+    }
+#endif
+}
+
+template <class Callback>
+void RabinKarpSet::Probe(std::string_view text, size_t idx, uint32_t hash, Callback&& on_match) const {
+    if (!((filter[(hash >> filter_shift) / 64] >> ((hash >> filter_shift) % 64)) & 1)) {
+        return;
+    }
+    for (size_t slot = Slot(hash); slot_pattern[slot] != EMPTY; slot = (slot + 1) & mask) {
+        if (slot_hash[slot] == hash &&
+            !memcmp(text.data() + idx, pattern_data.data() + slot_pattern[slot] * pattern_length,
+                    pattern_length)) {
+            on_match(slot_pattern[slot], idx);
+        }
+    }
+}
+
+template <class Callback>
+void RabinKarpSet::Search(std::string_view text, Callback&& on_match) const {
+    if (text.length() < pattern_length) {
+        return;
+    }
+    const size_t windows = text.length() - pattern_length + 1;
+    const size_t lane_length = std::max(MIN_LANE_LENGTH, 4 * pattern_length);
+    std::vector<uint32_t> hashes(lane_length * LANES);
+
+    for (size_t segment = 0; segment < windows; segment += lane_length * LANES) {
+        // Короткий последний сегмент режется на полосы поровну
+        const size_t segment_windows = std::min(windows - segment, lane_length * LANES);
+        const size_t steps = (segment_windows + LANES - 1) / LANES;
+        size_t start[LANES];
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            start[lane] = segment + lane * steps;
+        }
+        HashLanes(text, start, steps, hashes.data());
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            for (size_t step = 0; step < steps && start[lane] + step < segment + segment_windows; ++step) {
+                Probe(text, start[lane] + step, hashes[step * LANES + lane], on_match);
+            }
+        }
+    }
+}
+
+#endif //SUBSTRING_RABIN_KARP_H
@@ -0,0 +1,69 @@
+/*
+ Построение суффиксного массива на строках длины 10^7:
+ последовательный SA-IS против ParallelSuffixArray на 1, 2, 4, ... потоках
+ с проверкой совпадения результатов. Fibonacci - много раундов удвоения (длинные LCP).
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "parallel_suffix_array.h"
+#include "suffix_array.h"
+
+const size_t LENGTH = 10000000;
+
+template <class Function>
+double Milliseconds(Function&& function) {
+    auto begin = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - begin;
+    return time.count();
+}
+
+std::string Random(size_t alphabet_size) {
+    std::mt19937 generator(1);
+    std::string result(LENGTH, 'a');
+    for (auto& ch : result) {
+        ch = static_cast<char>('a' + generator() % alphabet_size);
+    }
+    return result;
+}
+
+std::string Fibonacci(size_t length) {
+    std::string prev = "a";
+    std::string current = "ab";
+    while (current.length() < length) {
+        std::string next = current + prev;
+        prev = std::move(current);
+        current = std::move(next);
+    }
+    current.resize(length);
+    return current;
+}
+
+void Report(const char* name, const std::string& str) {
+    std::vector<uint32_t> sequential;
+    double sequential_time = Milliseconds([&] { sequential = SuffixArray<uint32_t>(str); });
+    printf("%-10s sa-is: %7.1f ms", name, sequential_time);
+    const size_t max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 8);
+    for (size_t threads_count = 1; threads_count <= max_threads; threads_count *= 2) {
+        std::vector<uint32_t> parallel;
+        double time = Milliseconds([&] { parallel = ParallelSuffixArray<uint32_t>(str, threads_count); });
+        printf(" | %zu: %7.1f ms%s", threads_count, time, parallel == sequential ? "" : " MISMATCH");
+    }
+    printf("\n");
+}
+
+int main() {
+    printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    Report("random 4", Random(4));
+    Report("random 26", Random(26));
+    Report("fibonacci", Fibonacci(LENGTH));
+    return 0;
+}
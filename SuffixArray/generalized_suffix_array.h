@@ -0,0 +1,299 @@
+#ifndef SUFFIXARRAY_GENERALIZED_SUFFIX_ARRAY_H
+#define SUFFIXARRAY_GENERALIZED_SUFFIX_ARRAY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "suffix_array.h"
+
+/*
+ Суффиксный массив N строк: текст s_0 #_0 s_1 #_1 ... s_{N-1} #_{N-1}, где #_i - символ i,
+ а символ строки c кодируется как N + c. Разделители уникальны и меньше любых символов,
+ поэтому LCP никогда их не пересекает, а ранги 0..N-1 заняты суффиксами из одного разделителя.
+ Owner(rank) - номер строки, которой принадлежит суффикс.
+ Запросы:
+ LongestCommonSubstring(k) - самая длинная подстрока, встречающаяся хотя бы в k строках:
+     минимальные окна рангов с k разными владельцами, минимум LCP в окне - дек. Time: O(n log N)
+ CountCommonToAll() - число различных подстрок, встречающихся во всех N строках:
+     f(r) - наибольшая длина префикса суффикса r, встречающегося во всех строках, ответ - сумма
+     max(0, f(r) - lcp[r]). Time: O(n log N)
+ Occurrences(pattern) - число вхождений pattern в каждую строку. Time: O(m log n + occ)
+ Memory: O(n + N)
+ */
+template <class Index = uint32_t>
+class GeneralizedSuffixArray {
+public:
+    explicit GeneralizedSuffixArray(const std::vector<std::string>& strings);
+
+    size_t StringsCount() const;
+
+    // Длина общего текста вместе с разделителями
+    size_t Size() const;
+
+    // Позиция суффикса ранга rank в общем тексте
+    size_t Suffix(size_t rank) const;
+
+    // LCP суффиксов рангов rank - 1 и rank, Lcp(0) = 0
+    size_t Lcp(size_t rank) const;
+
+    size_t Owner(size_t rank) const;
+
+    // Префикс длины length суффикса ранга rank, без разделителей
+    std::string Prefix(size_t rank, size_t length) const;
+
+    std::string LongestCommonSubstring(size_t k) const;
+
+    uint64_t CountCommonToAll() const;
+
+    std::vector<uint64_t> Occurrences(const std::string& pattern) const;
+
+    ~GeneralizedSuffixArray() = default;
+
+private:
+    // Длина суффикса до разделителя своей строки
+    size_t LengthToSentinel(size_t rank) const;
+
+    std::vector<Index> text;
+    std::vector<size_t> starts;  // starts[i] - начало s_i, starts[N] - длина текста
+    std::vector<Index> suffix_array;
+    std::vector<Index> lcp;
+};
+
+template <class Index>
+GeneralizedSuffixArray<Index>::GeneralizedSuffixArray(const std::vector<std::string>& strings):
+        text(), starts(), suffix_array(), lcp() {
+    const size_t strings_count = strings.size();
+    for (size_t i = 0; i < strings_count; ++i) {
+        starts.push_back(text.size());
+        for (char ch : strings[i]) {
+            text.push_back(strings_count + static_cast<unsigned char>(ch));
+        }
+        text.push_back(i);
+    }
+    starts.push_back(text.size());
+    suffix_array = SuffixArrayFromSymbols<Index>(text, strings_count + 256);
+    lcp = LcpArray(text, suffix_array);
+}
+
+template <class Index>
+size_t GeneralizedSuffixArray<Index>::StringsCount() const {
+    return starts.size() - 1;
+}
+
+template <class Index>
+size_t GeneralizedSuffixArray<Index>::Size() const {
+    return text.size();
+}
+
+template <class Index>
+size_t GeneralizedSuffixArray<Index>::Suffix(size_t rank) const {
+    return suffix_array[rank];
+}
+
+template <class Index>
+size_t GeneralizedSuffixArray<Index>::Lcp(size_t rank) const {
+    return lcp[rank];
+}
+
+template <class Index>
+size_t GeneralizedSuffixArray<Index>::Owner(size_t rank) const {
+    return std::upper_bound(starts.begin(), starts.end(), size_t(suffix_array[rank])) - starts.begin() - 1;
+}
+
+template <class Index>
+size_t GeneralizedSuffixArray<Index>::LengthToSentinel(size_t rank) const {
+    return starts[Owner(rank) + 1] - 1 - suffix_array[rank];
+}
+
+template <class Index>
+std::string GeneralizedSuffixArray<Index>::Prefix(size_t rank, size_t length) const {
+    const size_t strings_count = StringsCount();
+    std::string prefix(length, '\0');
+    for (size_t i = 0; i < length; ++i) {
+        prefix[i] = static_cast<char>(text[suffix_array[rank] + i] - strings_count);
+    }
+    return prefix;
+}
+
+template <class Index>
+std::string GeneralizedSuffixArray<Index>::LongestCommonSubstring(size_t k) const {
+    const size_t strings_count = StringsCount();
+    if (!k || k > strings_count) {
+        return "";
+    }
+    size_t best_rank = 0;
+    size_t best_length = 0;
+    if (k == 1) {
+        for (size_t rank = strings_count; rank < Size(); ++rank) {
+            if (LengthToSentinel(rank) > best_length) {
+                best_rank = rank;
+                best_length = LengthToSentinel(rank);
+            }
+        }
+        return Prefix(best_rank, best_length);
+    }
+
+    // Окно рангов (left, right]: LCP-минимум по lcp[left + 1..right], дек индексов с возрастающим lcp
+    std::vector<size_t> counts(strings_count);
+    size_t distinct = 0;
+    std::deque<size_t> minimum;
+    size_t left = strings_count;
+    for (size_t right = strings_count; right < Size(); ++right) {
+        if (!counts[Owner(right)]++) {
+            ++distinct;
+        }
+        if (right > left) {
+            while (!minimum.empty() && lcp[minimum.back()] >= lcp[right]) {
+                minimum.pop_back();
+            }
+            minimum.push_back(right);
+        }
+        while (left < right && (counts[Owner(left)] > 1 || distinct > k)) {
+            if (!--counts[Owner(left)]) {
+                --distinct;
+            }
+            ++left;
+            while (!minimum.empty() && minimum.front() <= left) {
+                minimum.pop_front();
+            }
+        }
+        if (distinct >= k && lcp[minimum.front()] > best_length) {
+            best_rank = right;
+            best_length = lcp[minimum.front()];
+        }
+    }
+    return Prefix(best_rank, best_length);
+}
+
+template <class Index>
+uint64_t GeneralizedSuffixArray<Index>::CountCommonToAll() const {
+    const size_t strings_count = StringsCount();
+    const size_t size = Size();
+    uint64_t count = 0;
+    if (strings_count == 1) {
+        for (size_t rank = 1; rank < size; ++rank) {
+            count += LengthToSentinel(rank) - lcp[rank];
+        }
+        return count;
+    }
+
+    // Минимальное окно со всеми строками, кончающееся в right: [window_begin[right], right],
+    // его значение - минимум LCP внутри; best_from[a] - лучшее значение окон, начинающихся в a
+    const size_t NONE = std::numeric_limits<size_t>::max();
+    std::vector<size_t> window_begin(size, NONE);
+    std::vector<Index> value(size);
+    std::vector<Index> best_from(size);
+    std::vector<size_t> counts(strings_count);
+    size_t distinct = 0;
+    std::deque<size_t> minimum;
+    size_t left = strings_count;
+    for (size_t right = strings_count; right < size; ++right) {
+        if (!counts[Owner(right)]++) {
+            ++distinct;
+        }
+        if (right > left) {
+            while (!minimum.empty() && lcp[minimum.back()] >= lcp[right]) {
+                minimum.pop_back();
+            }
+            minimum.push_back(right);
+        }
+        while (left < right && counts[Owner(left)] > 1) {
+            --counts[Owner(left)];
+            ++left;
+            while (!minimum.empty() && minimum.front() <= left) {
+                minimum.pop_front();
+            }
+        }
+        if (distinct == strings_count) {
+            window_begin[right] = left;
+            value[right] = lcp[minimum.front()];
+            best_from[left] = std::max(best_from[left], value[right]);
+        }
+    }
+
+    // f(r): либо окно накрывает r (максимум значений окон с концом >= r и началом <= r - дек),
+    // либо окно правее r: min(lcp[r + 1..begin], значение), считается проходом справа
+    std::vector<Index> common(size);
+    size_t right_best = 0;
+    for (size_t rank = size; rank-- > strings_count;) {
+        if (rank + 1 < size) {
+            right_best = std::min<size_t>(lcp[rank + 1], std::max<size_t>(right_best, best_from[rank + 1]));
+        }
+        common[rank] = right_best;
+    }
+    std::deque<size_t> maximum;
+    size_t next_window = strings_count;
+    for (size_t rank = strings_count; rank < size; ++rank) {
+        for (; next_window < size && (window_begin[next_window] == NONE || window_begin[next_window] <= rank);
+             ++next_window) {
+            if (window_begin[next_window] == NONE) {
+                continue;
+            }
+            while (!maximum.empty() && value[maximum.back()] <= value[next_window]) {
+                maximum.pop_back();
+            }
+            maximum.push_back(next_window);
+        }
+        while (!maximum.empty() && maximum.front() < rank) {
+            maximum.pop_front();
+        }
+        const size_t covering = maximum.empty() ? 0 : value[maximum.front()];
+        const size_t longest = std::max<size_t>(common[rank], covering);
+        count += longest > lcp[rank] ? longest - lcp[rank] : 0;
+    }
+    return count;
+}
+
+template <class Index>
+std::vector<uint64_t> GeneralizedSuffixArray<Index>::Occurrences(const std::string& pattern) const {
+    const size_t strings_count = StringsCount();
+    // Сравнение префикса суффикса с образцом: -1, 0 (образец - префикс суффикса), 1
+    auto compare = [&](size_t rank) {
+        const size_t pos = suffix_array[rank];
+        for (size_t i = 0; i < pattern.length(); ++i) {
+            const size_t symbol = strings_count + static_cast<unsigned char>(pattern[i]);
+            if (pos + i == Size() || text[pos + i] < symbol) {
+                return -1;
+            }
+            if (text[pos + i] > symbol) {
+                return 1;
+            }
+        }
+        return 0;
+    };
+    size_t begin = strings_count;
+    size_t end = Size();
+    size_t low = begin;
+    size_t high = end;
+    while (low < high) {
+        const size_t middle = (low + high) / 2;
+        if (compare(middle) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    begin = low;
+    high = end;
+    while (low < high) {
+        const size_t middle = (low + high) / 2;
+        if (compare(middle) <= 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    end = low;
+
+    std::vector<uint64_t> occurrences(strings_count);
+    for (size_t rank = begin; rank < end; ++rank) {
+        ++occurrences[Owner(rank)];
+    }
+    return occurrences;
+}
+
+#endif //SUFFIXARRAY_GENERALIZED_SUFFIX_ARRAY_H
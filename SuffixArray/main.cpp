@@ -0,0 +1,37 @@
+/*
+ * Description(Russian):
+ * Дана строка длины n. Найти количество её различных подстрок.
+ * Каждый суффикс в порядке суффиксного массива добавляет столько новых подстрок,
+ * сколько его префиксов длиннее LCP с предыдущим суффиксом.
+ * Time: O(n)
+ * Memory: O(n)
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "suffix_array.h"
+
+template <class Index>
+uint64_t DistinctSubstrings(const std::string& str) {
+    auto suffix_array = SuffixArray<Index>(str);
+    auto lcp = LcpArray(str, suffix_array);
+    uint64_t count = 0;
+    for (size_t r = 0; r < suffix_array.size(); ++r) {
+        count += str.length() - suffix_array[r] - lcp[r];
+    }
+    return count;
+}
+
+int main() {
+    std::ios_base::sync_with_stdio(false);
+    std::string str;
+    std::cin >> str;
+    const uint64_t count = str.length() < std::numeric_limits<uint32_t>::max() ?
+                           DistinctSubstrings<uint32_t>(str) : DistinctSubstrings<uint64_t>(str);
+    printf("%llu\n", static_cast<unsigned long long>(count));
+    return 0;
+}
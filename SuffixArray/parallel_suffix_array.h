@@ -0,0 +1,181 @@
+#ifndef SUFFIXARRAY_PARALLEL_SUFFIX_ARRAY_H
+#define SUFFIXARRAY_PARALLEL_SUFFIX_ARRAY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ Суффиксный массив удвоением префиксов в threads_count потоков, результат совпадает с SuffixArray.
+ Ранг суффикса - индекс начала его группы в массиве (группа - суффиксы с равными первыми k символами).
+ Раунд k -> 2k:
+ 1. Порядок по второму ключу rank[i + k] берётся из текущего массива без сортировки:
+    сначала суффиксы длины не больше k, затем sa[r] - k по порядку (параллельное сжатие).
+ 2. Устойчивая поразрядная сортировка по первому ключу rank[i] разрядами по 16 бит:
+    у каждого потока своя гистограмма, смещения (разряд, поток) дают устойчивую раскладку.
+ 3. Новые ранги - префиксный максимум начал групп, считается по кускам с переносом.
+ Раунды идут, пока все ранги не станут различны.
+ Time: O(n log n) work, O(n log n / threads_count + threads_count * 2^16 * log n) per thread
+ Memory: O(n + threads_count * 2^16)
+ */
+template <class Index = uint32_t>
+std::vector<Index> ParallelSuffixArray(const std::string& str,
+                                       size_t threads_count = std::thread::hardware_concurrency());
+
+// function(begin, end, thread_idx) для threads_count равных кусков [0, size)
+template <class Function>
+void ParallelFor(size_t threads_count, size_t size, Function&& function) {
+    std::vector<std::thread> threads;
+    const size_t chunk = (size + threads_count - 1) / threads_count;
+    for (size_t t = 1; t < threads_count; ++t) {
+        const size_t begin = std::min(size, t * chunk);
+        threads.emplace_back([&function, begin, end = std::min(size, begin + chunk), t] {
+            function(begin, end, t);
+        });
+    }
+    function(0, std::min(size, chunk), 0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+template <class Index>
+std::vector<Index> ParallelSuffixArray(const std::string& str, size_t threads_count) {
+    const size_t RADIX_BITS = 16;
+    const size_t RADIX = size_t(1) << RADIX_BITS;
+    const size_t length = str.length();
+    threads_count = std::max<size_t>(1, std::min(threads_count, length / RADIX + 1));
+
+    std::vector<Index> suffix_array(length);
+    std::vector<Index> buffer(length);
+    std::vector<Index> rank(length);
+    std::vector<Index> next_rank(length);
+    std::vector<std::vector<Index>> histograms(threads_count, std::vector<Index>(RADIX));
+    std::vector<size_t> chunk_values(threads_count);
+
+    // Устойчивая сортировка from -> to по разряду rank[pos] начиная с бита shift
+    auto radix_pass = [&](const std::vector<Index>& from, std::vector<Index>& to, size_t shift) {
+        ParallelFor(threads_count, length, [&](size_t begin, size_t end, size_t t) {
+            auto& histogram = histograms[t];
+            std::fill(histogram.begin(), histogram.end(), 0);
+            for (size_t i = begin; i < end; ++i) {
+                ++histogram[(rank[from[i]] >> shift) & (RADIX - 1)];
+            }
+        });
+        size_t offset = 0;
+        for (size_t digit = 0; digit < RADIX; ++digit) {
+            for (auto& histogram : histograms) {
+                const size_t count = histogram[digit];
+                histogram[digit] = offset;
+                offset += count;
+            }
+        }
+        ParallelFor(threads_count, length, [&](size_t begin, size_t end, size_t t) {
+            auto& histogram = histograms[t];
+            for (size_t i = begin; i < end; ++i) {
+                to[histogram[(rank[from[i]] >> shift) & (RADIX - 1)]++] = from[i];
+            }
+        });
+    };
+    // Сортировка order по rank, результат в suffix_array; order становится вторым буфером
+    auto sort_by_rank = [&](std::vector<Index>& order, size_t max_rank) {
+        size_t passes = 1;
+        while (passes * RADIX_BITS < 8 * sizeof(Index) && (max_rank >> (passes * RADIX_BITS))) {
+            ++passes;
+        }
+        for (size_t pass = 0; pass < passes; ++pass) {
+            if (pass % 2) {
+                radix_pass(suffix_array, order, pass * RADIX_BITS);
+            } else {
+                radix_pass(order, suffix_array, pass * RADIX_BITS);
+            }
+        }
+        if (passes % 2 == 0) {
+            suffix_array.swap(order);
+        }
+    };
+    // Ранги по отсортированному массиву: начало группы равных по same соседей; возвращает число групп
+    auto rerank = [&](auto&& same) {
+        ParallelFor(threads_count, length, [&](size_t begin, size_t end, size_t t) {
+            size_t head = 0;
+            for (size_t r = begin; r < end; ++r) {
+                if (!r || !same(suffix_array[r - 1], suffix_array[r])) {
+                    head = r;
+                }
+            }
+            chunk_values[t] = head;
+        });
+        std::vector<size_t> carry(threads_count);
+        for (size_t t = 1; t < threads_count; ++t) {
+            carry[t] = std::max(carry[t - 1], chunk_values[t - 1]);
+        }
+        ParallelFor(threads_count, length, [&](size_t begin, size_t end, size_t t) {
+            size_t head = carry[t];
+            size_t groups = 0;
+            for (size_t r = begin; r < end; ++r) {
+                if (!r || !same(suffix_array[r - 1], suffix_array[r])) {
+                    head = r;
+                    ++groups;
+                }
+                next_rank[suffix_array[r]] = head;
+            }
+            chunk_values[t] = groups;
+        });
+        rank.swap(next_rank);
+        size_t groups = 0;
+        for (size_t value : chunk_values) {
+            groups += value;
+        }
+        return groups;
+    };
+
+    ParallelFor(threads_count, length, [&](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; ++i) {
+            rank[i] = static_cast<unsigned char>(str[i]);
+            buffer[i] = i;
+        }
+    });
+    sort_by_rank(buffer, 255);
+    size_t groups = rerank([&](size_t lhv, size_t rhv) { return str[lhv] == str[rhv]; });
+
+    for (size_t k = 1; groups < length; k *= 2) {
+        // Второй ключ: суффиксы [length - k, length) пусты после сдвига и идут первыми
+        const size_t shorter = std::min(k, length);
+        for (size_t i = 0; i < shorter; ++i) {
+            buffer[i] = length - shorter + i;
+        }
+        ParallelFor(threads_count, length, [&](size_t begin, size_t end, size_t t) {
+            size_t count = 0;
+            for (size_t r = begin; r < end; ++r) {
+                count += suffix_array[r] >= k;
+            }
+            chunk_values[t] = count;
+        });
+        std::vector<size_t> positions(threads_count, shorter);
+        for (size_t t = 1; t < threads_count; ++t) {
+            positions[t] = positions[t - 1] + chunk_values[t - 1];
+        }
+        ParallelFor(threads_count, length, [&](size_t begin, size_t end, size_t t) {
+            size_t pos = positions[t];
+            for (size_t r = begin; r < end; ++r) {
+                if (suffix_array[r] >= k) {
+                    buffer[pos++] = suffix_array[r] - k;
+                }
+            }
+        });
+        sort_by_rank(buffer, length - 1);
+        groups = rerank([&](size_t lhv, size_t rhv) {
+            if (rank[lhv] != rank[rhv]) {
+                return false;
+            }
+            const size_t lhv_second = lhv + k < length ? rank[lhv + k] + 1 : 0;
+            const size_t rhv_second = rhv + k < length ? rank[rhv + k] + 1 : 0;
+            return lhv_second == rhv_second;
+        });
+    }
+    return suffix_array;
+}
+
+#endif //SUFFIXARRAY_PARALLEL_SUFFIX_ARRAY_H
@@ -0,0 +1,197 @@
+#ifndef SUFFIXARRAY_SUFFIX_ARRAY_H
+#define SUFFIXARRAY_SUFFIX_ARRAY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/*
+ Суффиксный массив SA-IS (Nong, Zhang, Chan) и LCP по Касаи.
+ Index - тип позиций, должен вмещать длину текста.
+ SuffixArrayFromSymbols принимает текст над целочисленным алфавитом [0, alphabet_size).
+ lcp[r] - длина общего префикса суффиксов sa[r - 1] и sa[r], lcp[0] = 0.
+ Имена LMS-подстрок хранятся в свободной части самого суффиксного массива, так что при байтовом
+ тексте и 32-битном Index пик около 9n байт (4n массив + сокращённая строка и её рекурсия),
+ LcpArray добавляет ещё 8n.
+ Time: O(n + alphabet_size)
+ Memory: O(n)
+ */
+
+template <class Index = uint32_t>
+std::vector<Index> SuffixArray(const std::string& str);
+
+template <class Index, class Symbol>
+std::vector<Index> SuffixArrayFromSymbols(const std::vector<Symbol>& text, size_t alphabet_size);
+
+template <class Index, class Text>
+std::vector<Index> LcpArray(const Text& text, const std::vector<Index>& suffix_array);
+
+template <class Index, class Symbol>
+std::vector<Index> SuffixArrayFromSymbols(const std::vector<Symbol>& text, size_t alphabet_size) {
+    const Index NONE = std::numeric_limits<Index>::max();
+    const size_t length = text.size();
+    if (length < 2) {
+        return std::vector<Index>(length, 0);
+    }
+
+    // S-тип: суффикс меньше следующего. Последний суффикс - L-тип (за ним виртуальный минимальный символ)
+    std::vector<bool> is_s(length);
+    for (size_t i = length - 1; i-- > 0;) {
+        is_s[i] = text[i] == text[i + 1] ? is_s[i + 1] : text[i] < text[i + 1];
+    }
+    // Корзины символов: L-суффиксы в начале корзины, S - в конце
+    std::vector<Index> bucket_l(alphabet_size + 1);
+    std::vector<Index> bucket_s(alphabet_size + 1);
+    for (size_t i = 0; i < length; ++i) {
+        if (is_s[i]) {
+            ++bucket_l[text[i] + 1];
+        } else {
+            ++bucket_s[text[i]];
+        }
+    }
+    for (size_t ch = 0; ch <= alphabet_size; ++ch) {
+        bucket_s[ch] += bucket_l[ch];
+        if (ch < alphabet_size) {
+            bucket_l[ch + 1] += bucket_s[ch];
+        }
+    }
+
+    std::vector<Index> suffix_array(length);
+    std::vector<Index> bucket(alphabet_size + 1);
+    // Индуцированная сортировка по упорядоченным LMS-позициям
+    auto induce = [&](const std::vector<Index>& lms) {
+        std::fill(suffix_array.begin(), suffix_array.end(), NONE);
+        std::copy(bucket_s.begin(), bucket_s.end(), bucket.begin());
+        for (Index pos : lms) {
+            suffix_array[bucket[text[pos]]++] = pos;
+        }
+        std::copy(bucket_l.begin(), bucket_l.end(), bucket.begin());
+        suffix_array[bucket[text[length - 1]]++] = length - 1;
+        for (size_t i = 0; i < length; ++i) {
+            const Index pos = suffix_array[i];
+            if (pos != NONE && pos >= 1 && !is_s[pos - 1]) {
+                suffix_array[bucket[text[pos - 1]]++] = pos - 1;
+            }
+        }
+        std::copy(bucket_l.begin(), bucket_l.end(), bucket.begin());
+        for (size_t i = length; i-- > 0;) {
+            const Index pos = suffix_array[i];
+            if (pos != NONE && pos >= 1 && is_s[pos - 1]) {
+                suffix_array[--bucket[text[pos - 1] + 1]] = pos - 1;
+            }
+        }
+    };
+
+    auto is_lms = [&is_s](size_t pos) {
+        return pos > 0 && is_s[pos] && !is_s[pos - 1];
+    };
+    std::vector<Index> lms;
+    for (size_t i = 1; i < length; ++i) {
+        if (is_lms(i)) {
+            lms.push_back(i);
+        }
+    }
+    induce(lms);
+    const size_t lms_count = lms.size();
+    if (!lms_count) {
+        return suffix_array;
+    }
+    lms = std::vector<Index>();
+
+    // Отсортированные LMS-позиции сжимаются в начало массива. LMS-позиции отстоят хотя бы на 2,
+    // поэтому имя позиции pos помещается в свободный хвост по индексу lms_count + pos / 2
+    size_t sorted = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (is_lms(suffix_array[i])) {
+            suffix_array[sorted++] = suffix_array[i];
+        }
+    }
+    std::fill(suffix_array.begin() + lms_count, suffix_array.end(), NONE);
+    // LMS-подстрока - от LMS-позиции до следующей включительно (последняя - до конца текста)
+    auto lms_end = [&](size_t pos) {
+        do {
+            ++pos;
+        } while (pos < length && !is_lms(pos));
+        return pos;
+    };
+    size_t names = 0;
+    suffix_array[lms_count + suffix_array[0] / 2] = 0;
+    for (size_t i = 1; i < lms_count; ++i) {
+        size_t left = suffix_array[i - 1];
+        size_t right = suffix_array[i];
+        const size_t left_end = lms_end(left);
+        const size_t right_end = lms_end(right);
+        bool same = left_end - left == right_end - right;
+        if (same) {
+            while (left < left_end && text[left] == text[right]) {
+                ++left;
+                ++right;
+            }
+            same = left < length && right < length && text[left] == text[right];
+        }
+        if (!same) {
+            ++names;
+        }
+        suffix_array[lms_count + suffix_array[i] / 2] = names;
+    }
+    std::vector<Index> reduced;
+    reduced.reserve(lms_count);
+    for (size_t i = lms_count; i < length; ++i) {
+        if (suffix_array[i] != NONE) {
+            reduced.push_back(suffix_array[i]);
+        }
+    }
+
+    // Рекурсия по сокращённой строке имён задаёт порядок LMS-суффиксов
+    auto reduced_array = SuffixArrayFromSymbols<Index>(reduced, names + 1);
+    size_t lms_idx = 0;
+    for (size_t i = 1; i < length; ++i) {
+        if (is_lms(i)) {
+            reduced[lms_idx++] = i;
+        }
+    }
+    for (auto& pos : reduced_array) {
+        pos = reduced[pos];
+    }
+    reduced = std::vector<Index>();
+    induce(reduced_array);
+    return suffix_array;
+}
+
+template <class Index>
+std::vector<Index> SuffixArray(const std::string& str) {
+    std::vector<unsigned char> text(str.begin(), str.end());
+    return SuffixArrayFromSymbols<Index>(text, 256);
+}
+
+template <class Index, class Text>
+std::vector<Index> LcpArray(const Text& text, const std::vector<Index>& suffix_array) {
+    const size_t length = suffix_array.size();
+    std::vector<Index> rank(length);
+    for (size_t r = 0; r < length; ++r) {
+        rank[suffix_array[r]] = r;
+    }
+    // lcp следующего по тексту суффикса не меньше текущего минус один
+    std::vector<Index> lcp(length);
+    size_t common = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (!rank[i]) {
+            common = 0;
+            continue;
+        }
+        const size_t previous = suffix_array[rank[i] - 1];
+        while (i + common < length && previous + common < length &&
+               text[i + common] == text[previous + common]) {
+            ++common;
+        }
+        lcp[rank[i]] = common;
+        if (common) {
+            --common;
+        }
+    }
+    return lcp;
+}
+
+#endif //SUFFIXARRAY_SUFFIX_ARRAY_H
@@ -0,0 +1,138 @@
+/*
+ Скорость построения SuffixTree (Укконен) на строках s$t# суммарной длины до 10^7:
+ случайные над алфавитами 2 и 26 и периодическая (a^7b)^n - длинные цепочки суффиксных ссылок.
+ Рядом - исходная реализация ReferenceSuffixTree (таблица переходов в каждой вершине, копии Node
+ в активной точке) до REFERENCE_MAX_LENGTH символов: дальше ей не хватает памяти (~0.5 КБ на вершину).
+ Затем пропускная способность Count по 10^5 образцам: цикл по одному и CountBatch в 1, 2, 4, 8 потоков.
+ Наконец, старт с готового файла: построение + PrepareQueries против MappedSuffixTree + первый запрос.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mapped_suffix_tree.h"
+#include "reference_suffix_tree.h"
+#include "suffix_tree.h"
+
+template <class Function>
+double Milliseconds(Function&& function) {
+    auto begin = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - begin;
+    return time.count();
+}
+
+std::string Random(std::mt19937& generator, size_t length, size_t alphabet_size) {
+    std::string result(length, 'a');
+    for (auto& ch : result) {
+        ch = static_cast<char>('a' + generator() % alphabet_size);
+    }
+    return result;
+}
+
+std::string Repeat(const std::string& period, size_t length) {
+    std::string result;
+    while (result.length() < length) {
+        result += period;
+    }
+    result.resize(length);
+    return result;
+}
+
+const size_t REFERENCE_MAX_LENGTH = 2000002;
+
+void Report(const char* name, const std::string& s, const std::string& t) {
+    const std::string str = s + DIVIDER0 + t + DIVIDER1;
+    int node_count = 0;
+    double time = Milliseconds([&] {
+        SuffixTree tree(str);
+        node_count = tree.NodeCount();
+    });
+    printf("%-12s %9zu chars: %8.1f ms, %6.1f ns/char, %d nodes",
+           name, str.length(), time, time * 1e6 / str.length(), node_count);
+    if (str.length() <= REFERENCE_MAX_LENGTH) {
+        int reference_node_count = 0;
+        double reference_time = Milliseconds([&] {
+            ReferenceSuffixTree tree(str);
+            reference_node_count = tree.NodeCount();
+        });
+        printf(" | reference: %8.1f ms, %6.1f ns/char%s", reference_time, reference_time * 1e6 / str.length(),
+               reference_node_count == node_count ? "" : " MISMATCH");
+    }
+    printf("\n");
+}
+
+void ReportQueries(std::mt19937& generator, size_t length, size_t alphabet_size) {
+    const std::string s = Random(generator, length, alphabet_size);
+    const std::string t = Random(generator, length, alphabet_size);
+    const std::string str = s + DIVIDER0 + t + DIVIDER1;
+    SuffixTree tree(str);
+    double prepare_time = Milliseconds([&] { tree.PrepareQueries(); });
+    const SuffixTreeView view = tree.View();
+
+    // Половина образцов - подстроки текста, половина - случайные
+    const size_t PATTERNS_COUNT = 100000;
+    std::vector<std::string> patterns(PATTERNS_COUNT);
+    for (size_t i = 0; i < PATTERNS_COUNT; ++i) {
+        const size_t pattern_length = 4 + generator() % 13;
+        patterns[i] = i % 2 ? Random(generator, pattern_length, alphabet_size)
+                            : s.substr(generator() % (length - pattern_length), pattern_length);
+    }
+    printf("queries, random %zu, %zu chars: PrepareQueries %.1f ms\n", alphabet_size, str.length(), prepare_time);
+
+    long long total = 0;
+    double time = Milliseconds([&] {
+        for (const auto& pattern : patterns) {
+            total += view.Count(pattern);
+        }
+    });
+    printf("  Count loop:      %8.1f ms, %6.0f ns/query, %lld occurrences\n",
+           time, time * 1e6 / PATTERNS_COUNT, total);
+    for (size_t threads_count : {1, 2, 4, 8}) {
+        total = 0;
+        time = Milliseconds([&] {
+            for (int count : view.CountBatch(patterns, threads_count)) {
+                total += count;
+            }
+        });
+        printf("  CountBatch x%zu:   %8.1f ms, %6.0f ns/query, %lld occurrences\n",
+               threads_count, time, time * 1e6 / PATTERNS_COUNT, total);
+    }
+}
+
+void ReportMapped(std::mt19937& generator, size_t length) {
+    const std::string str = Random(generator, length, 26) + DIVIDER0 + Random(generator, length, 26) + DIVIDER1;
+    const std::string path = "suffix_tree_benchmark.bin";
+    const std::string pattern = str.substr(length / 2, 8);
+    int count = 0;
+    double build_time = Milliseconds([&] {
+        SuffixTree tree(str);
+        tree.PrepareQueries();
+        count = tree.View().Count(pattern);
+        tree.Save(path);
+    });
+    int mapped_count = 0;
+    double map_time = Milliseconds([&] {
+        MappedSuffixTree tree(path);
+        mapped_count = tree.View().Count(pattern);
+    });
+    std::remove(path.c_str());
+    printf("startup, random 26, %zu chars: build + save %.1f ms, map + first query %.3f ms (%d = %d)\n",
+           str.length(), build_time, map_time, count, mapped_count);
+}
+
+int main() {
+    std::mt19937 generator(1);
+    for (size_t length : {100000, 1000000, 5000000}) {
+        Report("random 2", Random(generator, length, 2), Random(generator, length, 2));
+        Report("random 26", Random(generator, length, 26), Random(generator, length, 26));
+        Report("(a^7b)^n", Repeat("aaaaaaab", length), Repeat("aaaaaaab", length));
+    }
+    ReportQueries(generator, 1000000, 2);
+    ReportQueries(generator, 1000000, 26);
+    ReportMapped(generator, 1000000);
+    return 0;
+}
@@ -0,0 +1,170 @@
+#ifndef SUFFIXTREE_MAPPED_SUFFIX_TREE_H
+#define SUFFIXTREE_MAPPED_SUFFIX_TREE_H
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "suffix_tree.h"
+
+/*
+ Дерево, записанное SuffixTree::Save, отображённое в память только для чтения (POSIX mmap, MAP_SHARED).
+ Разбора нет: SuffixTreeView смотрит прямо в отображение, страницы общие у всех процессов,
+ открывших один файл. Таблица корня берётся из файла, если она там есть,
+ так что флаг SUFFIX_TREE_DENSE_ROOT у писателя и читателя может различаться.
+ При открытии проверяются заголовок и все индексы, по которым ходят запросы: дети, братья (по возрастанию
+ первого символа, иначе обход списка мог бы зациклиться), рёбра, таблица корня, отрезки листьев.
+ Ошибки открытия, несовпадение формата и испорченный файл - std::runtime_error, а не чтение за границами.
+ Time: O(n) открытие (проход по узлам и листьям), запросы как у SuffixTreeView
+ Memory: O(1) своей, файл - в страничном кэше
+ */
+class MappedSuffixTree {
+public:
+    explicit MappedSuffixTree(const std::string& path);
+
+    MappedSuffixTree(const MappedSuffixTree&) = delete;
+    MappedSuffixTree& operator = (const MappedSuffixTree&) = delete;
+
+    int NodeCount() const;
+
+    SuffixTreeView View() const;
+
+    ~MappedSuffixTree();
+
+private:
+    template <class T>
+    const T* Section(uint64_t offset) const;
+
+    // Все индексы узлов, рёбер и листьев в своих секциях
+    bool IndicesValid() const;
+
+    void* data;
+    size_t size;
+    const SuffixTreeFileHeader* header;
+};
+
+inline MappedSuffixTree::MappedSuffixTree(const std::string& path): data(MAP_FAILED), size(0), header(nullptr) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("MappedSuffixTree: cannot open " + path);
+    }
+    struct stat file_stat{};
+    if (fstat(fd, &file_stat) == 0) {
+        size = file_stat.st_size;
+    }
+    if (size < sizeof(SuffixTreeFileHeader)) {
+        close(fd);
+        throw std::runtime_error("MappedSuffixTree: " + path + ": not a suffix tree file");
+    }
+    data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error("MappedSuffixTree: cannot map " + path);
+    }
+
+    header = static_cast<const SuffixTreeFileHeader*>(data);
+    const uint64_t nodes_count = header->nodes_count;
+    const uint64_t length = header->length;
+    const uint64_t leaves_count = header->leaves_count;
+    // Каждая секция должна целиком лежать в файле
+    auto fits = [this](uint64_t offset, uint64_t bytes) {
+        return offset % 8 == 0 && offset <= size && bytes <= size - offset;
+    };
+    const char* error = nullptr;
+    if (std::memcmp(header->magic, SuffixTreeFileHeader::MAGIC, sizeof(header->magic)) != 0) {
+        error = "not a suffix tree file";
+    } else if (header->version != SuffixTreeFileHeader::VERSION) {
+        error = "unsupported version";
+    } else if (header->byte_order != SuffixTreeFileHeader::BYTE_ORDER_MARK ||
+               header->node_size != sizeof(SuffixTree::Node)) {
+        error = "written on an incompatible platform";
+    } else if (header->file_size != size || header->nodes_count <= 0 || header->length <= 0 ||
+               header->leaves_count < 0 ||
+               !fits(header->nodes_offset, nodes_count * sizeof(SuffixTree::Node)) ||
+               !fits(header->txt_offset, length) ||
+               !fits(header->leaf_begin_offset, nodes_count * sizeof(int)) ||
+               !fits(header->leaf_end_offset, nodes_count * sizeof(int)) ||
+               !fits(header->leaves_offset, leaves_count * sizeof(int)) ||
+               (header->has_root_table && !fits(header->root_table_offset, ALPHASIZE * sizeof(int)))) {
+        error = "truncated or corrupted";
+    } else if (!IndicesValid()) {
+        error = "corrupted node indices";
+    }
+    if (error) {
+        munmap(data, size);
+        throw std::runtime_error("MappedSuffixTree: " + path + ": " + error);
+    }
+}
+
+template <class T>
+const T* MappedSuffixTree::Section(uint64_t offset) const {
+    return reinterpret_cast<const T*>(static_cast<const char*>(data) + offset);
+}
+
+inline bool MappedSuffixTree::IndicesValid() const {
+    const auto* nodes = Section<SuffixTree::Node>(header->nodes_offset);
+    const char* txt = Section<char>(header->txt_offset);
+    const int* leaf_begin = Section<int>(header->leaf_begin_offset);
+    const int* leaf_end = Section<int>(header->leaf_end_offset);
+    const int* leaves = Section<int>(header->leaves_offset);
+    const int nodes_count = header->nodes_count;
+    auto is_node = [nodes_count](int idx) {
+        return idx >= 0 && idx < nodes_count;
+    };
+    for (int i = 0; i < nodes_count; ++i) {
+        const SuffixTree::Node& node = nodes[i];
+        if (!is_node(node.first_child) || !is_node(node.next_sibling) ||
+            leaf_begin[i] < 0 || leaf_begin[i] > leaf_end[i] || leaf_end[i] > header->leaves_count) {
+            return false;
+        }
+        // Ребро корня не читается, корень не бывает ребёнком
+        if (i && (node.start < 0 || node.start >= header->length || node.end < node.start)) {
+            return false;
+        }
+    }
+    // Братья проверяются после рёбер: их start уже в пределах текста
+    for (int i = 1; i < nodes_count; ++i) {
+        const int sibling = nodes[i].next_sibling;
+        if (sibling && txt[nodes[sibling].start] <= txt[nodes[i].start]) {
+            return false;
+        }
+    }
+    if (header->has_root_table) {
+        const int* root_table = Section<int>(header->root_table_offset);
+        for (int ch = 0; ch < ALPHASIZE; ++ch) {
+            if (!is_node(root_table[ch])) {
+                return false;
+            }
+        }
+    }
+    for (int i = 0; i < header->leaves_count; ++i) {
+        if (leaves[i] < 0 || leaves[i] >= header->length) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline int MappedSuffixTree::NodeCount() const {
+    return header->nodes_count;
+}
+
+inline SuffixTreeView MappedSuffixTree::View() const {
+    return SuffixTreeView(Section<SuffixTree::Node>(header->nodes_offset), Section<char>(header->txt_offset),
+                          header->length,
+                          header->has_root_table ? Section<int>(header->root_table_offset) : nullptr,
+                          Section<int>(header->leaf_begin_offset), Section<int>(header->leaf_end_offset),
+                          Section<int>(header->leaves_offset));
+}
+
+inline MappedSuffixTree::~MappedSuffixTree() {
+    munmap(data, size);
+}
+
+#endif //SUFFIXTREE_MAPPED_SUFFIX_TREE_H
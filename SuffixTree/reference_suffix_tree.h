@@ -0,0 +1,183 @@
+#ifndef SUFFIXTREE_REFERENCE_SUFFIX_TREE_H
+#define SUFFIXTREE_REFERENCE_SUFFIX_TREE_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "suffix_tree.h"
+
+/*
+ Исходное построение Укконена для сравнения в бенчмарке: у каждой вершины таблица на ALPHASIZE переходов,
+ активная точка и ожидающая ссылки вершина хранятся копиями Node.
+ Только построение и число вершин, результат совпадает с SuffixTree.
+
+ Время: O(n*|sigma|)
+ Память: O(n*|sigma|)
+*/
+class ReferenceSuffixTree {
+public:
+    ReferenceSuffixTree();
+    explicit ReferenceSuffixTree(const std::string& str);
+
+    struct Node {   // [start; end]
+        Node();
+        Node(int start, int end = INT32_MAX,
+             int suff_link = 0, int number = 0);
+        int start;
+        int end;
+        int suff_link;
+        int number;
+        int transitions[ALPHASIZE];
+
+        int edge_length(int position) {
+            return std::min(end - start, position - start) + 1;
+        }
+    };
+
+    struct ActivePoint {
+        ActivePoint();
+        explicit ActivePoint(Node root);
+        Node node;
+        int edge;
+        int len;
+        ~ActivePoint() = default;
+    };
+
+    void AddSuffLink(const Node& from);
+    void AddSuffLink(const Node& from, const Node& to);
+
+    void Descent(int node_number);
+
+    void Insert(char ch);
+
+    void Add(Node& node);
+
+    int NodeCount();
+
+    ~ReferenceSuffixTree() = default;
+
+private:
+    Node root;
+    ActivePoint point;
+    Node last;
+    Node dead_node;
+    int remainder;
+
+    int position = 0;
+
+    std::vector<char> txt;
+    std::vector<Node> nodes;
+};
+
+inline ReferenceSuffixTree::ReferenceSuffixTree() : root(-1, -1, -1), point(root), last(root),
+        dead_node(-1, -1, -1, -1), remainder(0), position(0), txt(), nodes() {}
+
+inline ReferenceSuffixTree::ReferenceSuffixTree(const std::string& str): ReferenceSuffixTree() {
+    nodes.push_back(root);
+    for (char ch : str) {
+        txt.push_back(ch);
+        Insert(ch);
+        ++position;
+    }
+}
+
+inline ReferenceSuffixTree::ActivePoint::ActivePoint(): node(), edge(0), len(0) {}
+
+inline ReferenceSuffixTree::ActivePoint::ActivePoint(Node root): node(root), edge(0), len(0) {}
+
+inline ReferenceSuffixTree::Node::Node(): start(0), end(INT32_MAX), suff_link(0),
+        number(0), transitions() {}
+
+inline ReferenceSuffixTree::Node::Node(int start, int end,
+        int suff_link, int number): start(start), end(end),
+        suff_link(suff_link), number(number), transitions() {}
+
+inline void ReferenceSuffixTree::AddSuffLink(const Node& from) {
+    if (last.number > -1) {
+        nodes[last.number].suff_link = from.number;
+    }
+    last = dead_node;
+}
+
+inline void ReferenceSuffixTree::AddSuffLink(const Node& from, const Node& to) {
+    if (last.number > -1) {
+        nodes[last.number].suff_link = from.number;
+    }
+    last = to;
+}
+
+inline void ReferenceSuffixTree::Descent(int node_number) {  // Спуск по ребру
+    point.edge += nodes[node_number].edge_length(position);
+    point.len -= nodes[node_number].edge_length(position);
+    point.node.number = node_number;
+}
+
+inline void ReferenceSuffixTree::Add(Node& node) {
+    node.number = nodes.size();
+    nodes.push_back(node);
+}
+
+inline void ReferenceSuffixTree::Insert(char ch) {
+    ++remainder;
+    last = dead_node;
+    while (remainder) {
+
+        if (!point.len) {
+            point.edge = position;
+        }
+
+        if (!nodes[point.node.number].transitions[static_cast<int>(txt[point.edge])]) {  // Правило #2
+
+            Node leaf(position);
+            Add(leaf);
+            nodes[point.node.number].transitions[static_cast<int>(txt[point.edge])] = leaf.number;
+            AddSuffLink(point.node);
+
+        } else {
+            int next = nodes[point.node.number].transitions[static_cast<int>(txt[point.edge])];
+
+            if (point.len >= nodes[next].edge_length(position)) {
+                Descent(next);
+                continue;
+            }
+
+            if (txt[nodes[next].start + point.len] == ch) {
+                if (point.node.number) {
+                    AddSuffLink(point.node);
+                }
+                ++point.len;
+                break;
+            }
+
+            // Строим развилку
+            Node split = Node(nodes[next].start, nodes[next].start + point.len - 1);
+            Add(split);
+            nodes[point.node.number].transitions[static_cast<int>(txt[point.edge])] = split.number;
+
+            Node leaf = Node(position);
+            Add(leaf);
+            nodes[split.number].transitions[static_cast<int>(ch)] = leaf.number;
+
+            nodes[next].start += point.len;
+            nodes[split.number].transitions[static_cast<int>(txt[nodes[next].start])] = next;
+
+            AddSuffLink(split, split);
+        }
+
+        --remainder;
+
+        if (!point.node.number && point.len) {        // Правило #1
+            --point.len;
+            point.edge = position - remainder + 1;
+        } else if (point.node.number) {               // Правило #3
+            point.node = nodes[nodes[point.node.number].suff_link];
+        }
+    }
+}
+
+inline int ReferenceSuffixTree::NodeCount() {
+    return nodes.size();
+}
+
+#endif //SUFFIXTREE_REFERENCE_SUFFIX_TREE_H
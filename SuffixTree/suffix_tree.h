@@ -0,0 +1,605 @@
+#ifndef SUFFIXTREE_SUFFIX_TREE_H
+#define SUFFIXTREE_SUFFIX_TREE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+ Сжатое суффиксное дерево строки s$t#.
+ В основе алгоритм Укконена построения суффиксного дерева,
+ https://stackoverflow.com/questions/9452701/ukkonens-suffix-tree-algorithm-in-plain-english/9513423#9513423
+
+ Дети вершины хранятся списком first_child/next_sibling, упорядоченным по первому символу ребра,
+ так что вершина занимает 20 байт вместо таблицы на ALPHASIZE переходов.
+ С SUFFIX_TREE_DENSE_ROOT корень хранит плотную таблицу: у него больше всего детей.
+
+ Запросы по образцу - через SuffixTreeView после PrepareQueries (текст должен кончаться
+ уникальным символом, чтобы каждый суффикс был листом).
+ Save пишет подготовленное дерево в файл, MappedSuffixTree (mapped_suffix_tree.h) отвечает по нему без разбора.
+
+ Время: O(n*|sigma|)
+ Память: O(n)
+*/
+
+const char DIVIDER0 = '$';
+const char DIVIDER1 = '#';
+const int ALPHASIZE = 'z' + 1;
+
+class SuffixTreeView;
+
+class SuffixTree {
+public:
+    SuffixTree();
+    explicit SuffixTree(const std::string& str);
+
+    struct Node {   // [start; end]
+        Node();
+        Node(int start, int end = INT32_MAX, int suff_link = 0);
+        int start;
+        int end;
+        int suff_link;
+        int first_child;   // 0 - нет (корень не бывает ребёнком)
+        int next_sibling;
+
+        int edge_length(int position) {
+            return std::min(end - start, position - start) + 1;
+        }
+    };
+
+    struct ActivePoint {   // Только индексы: вершина, начало ребра в txt, пройдено по ребру
+        ActivePoint();
+        int node;
+        int edge;
+        int len;
+        ~ActivePoint() = default;
+    };
+
+    void AddSuffLink(int from);
+    void AddSuffLink(int from, int to);
+
+    void Descent(int node_number);
+
+    // Ребёнок по первому символу ребра, 0 - если нет
+    int Transition(int node_number, char ch);
+
+    // Вешает child по символу txt[child.start], заменяя ребёнка с тем же символом
+    void SetTransition(int node_number, int child);
+
+    void Insert(char ch);
+
+    int Add(const Node& node);
+
+    int NodeCount();
+
+    int GetPosition();
+
+    // {родитель, номер строки, начало, конец} для каждой вершины кроме корня в прямом порядке
+    std::vector<std::array<int, 4>> NodeData() const;
+
+    /*
+     Прямой обход без рекурсии, стек - не больше одной записи на уровень глубины.
+     Вершины нумеруются с единицы в порядке обхода, корень - 0;
+     для каждой вызывается sink(parent, string_number, start, end). Дерево не меняется.
+     */
+    template <class Sink>
+    void EmitPreorder(Sink&& sink) const;
+
+    // Листья в прямом порядке и для каждой вершины отрезок своих листьев в нём: O(n), 12 байт на вершину.
+    // std::logic_error, если не каждый суффикс - лист (текст не кончается уникальным символом)
+    void PrepareQueries();
+
+    // Неизменяемое представление для запросов, std::logic_error без PrepareQueries
+    SuffixTreeView View() const;
+
+    // Образ дерева в формате SuffixTreeFileHeader, std::logic_error без PrepareQueries
+    void Save(const std::string& path) const;
+
+    ~SuffixTree() = default;
+
+private:
+    ActivePoint point;
+    int last;          // Вершина, ждущая суффиксную ссылку, -1 - нет
+    int remainder;
+    int last_in_s;
+
+    int position = 0;
+
+    std::vector<char> txt;
+    std::vector<Node> nodes;
+#ifdef SUFFIX_TREE_DENSE_ROOT
+    std::array<int, ALPHASIZE> root_transitions{};
+#endif
+
+    std::vector<int> leaf_begin;
+    std::vector<int> leaf_end;
+    std::vector<int> leaves;    // Начала суффиксов в лексикографическом порядке
+};
+
+/*
+ Файл SuffixTree::Save: заголовок, затем секции по смещениям из него, каждая выровнена на 8 байт:
+ nodes (SuffixTree::Node как в памяти: рёбра, суффиксные ссылки, списки детей), txt,
+ leaf_begin, leaf_end, leaves и, если есть, таблица переходов корня.
+ Числа - в порядке байт записавшей машины; читатель сверяет byte_order и размер Node.
+ Несовместимое изменение раскладки - новая VERSION.
+ */
+struct SuffixTreeFileHeader {
+    static constexpr char MAGIC[8] = "SFXTREE";
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t node_size;
+    uint32_t has_root_table;
+    int32_t length;         // Длина текста
+    int32_t nodes_count;
+    int32_t leaves_count;
+    uint32_t reserved;
+    uint64_t nodes_offset;
+    uint64_t txt_offset;
+    uint64_t leaf_begin_offset;
+    uint64_t leaf_end_offset;
+    uint64_t leaves_offset;
+    uint64_t root_table_offset;
+    uint64_t file_size;
+};
+
+static_assert(std::is_trivially_copyable<SuffixTree::Node>::value, "Node is written to disk as is");
+
+/*
+ Запросы по образцу длины m к построенному дереву поверх сырых указателей,
+ так что дерево может лежать и в памяти SuffixTree, и в отображённом файле.
+ Contains, Count - спуск по образцу O(m * |sigma|), Count берёт число листьев поддерева.
+ Locate - начала вхождений в тексте (в лексикографическом порядке суффиксов), + O(occ).
+ Пакетные варианты делят образцы между threads_count потоками: представление только читается.
+ */
+class SuffixTreeView {
+public:
+    SuffixTreeView(const SuffixTree::Node* nodes, const char* txt, int length, const int* root_transitions,
+                   const int* leaf_begin, const int* leaf_end, const int* leaves);
+
+    bool Contains(std::string_view pattern) const;
+
+    int Count(std::string_view pattern) const;
+
+    std::vector<int> Locate(std::string_view pattern) const;
+
+    std::vector<int> CountBatch(const std::vector<std::string>& patterns, size_t threads_count = 1) const;
+
+    std::vector<std::vector<int>> LocateBatch(const std::vector<std::string>& patterns,
+                                              size_t threads_count = 1) const;
+
+    ~SuffixTreeView() = default;
+
+private:
+    // Ребёнок по символу, 0 - если нет
+    int Child(int node_number, char ch) const;
+
+    // Вершина, под ребром в которую кончается образец, -1 - образца нет
+    int Locus(std::string_view pattern) const;
+
+    template <class Function>
+    void ForEachPattern(size_t patterns_count, size_t threads_count, Function&& function) const;
+
+    const SuffixTree::Node* nodes;
+    const char* txt;
+    int length;
+    const int* root_transitions;   // nullptr - у корня тоже список детей
+    const int* leaf_begin;
+    const int* leaf_end;
+    const int* leaves;
+};
+
+inline SuffixTree::SuffixTree() : point(), last(-1), remainder(0), last_in_s(0), position(0),
+        txt(), nodes() {}
+
+inline SuffixTree::SuffixTree(const std::string& str): SuffixTree() {
+    nodes.push_back(Node(-1, -1, -1));
+    for (char ch : str) {
+        txt.push_back(ch);
+        Insert(ch);
+        if (ch == DIVIDER0) {
+            last_in_s = txt.size() - 1;
+        }
+        ++position;
+    }
+}
+
+inline SuffixTree::ActivePoint::ActivePoint(): node(0), edge(0), len(0) {}
+
+inline SuffixTree::Node::Node(): start(0), end(INT32_MAX), suff_link(0),
+        first_child(0), next_sibling(0) {}
+
+inline SuffixTree::Node::Node(int start, int end, int suff_link): start(start), end(end),
+        suff_link(suff_link), first_child(0), next_sibling(0) {}
+
+inline void SuffixTree::AddSuffLink(int from) {
+    AddSuffLink(from, -1);
+}
+
+inline void SuffixTree::AddSuffLink(int from, int to) {
+    if (last > -1) {
+        nodes[last].suff_link = from;
+    }
+    last = to;
+}
+
+inline void SuffixTree::Descent(int node_number) {  // Спуск по ребру
+    point.edge += nodes[node_number].edge_length(position);
+    point.len -= nodes[node_number].edge_length(position);
+    point.node = node_number;
+}
+
+inline int SuffixTree::Transition(int node_number, char ch) {
+#ifdef SUFFIX_TREE_DENSE_ROOT
+    if (!node_number) {
+        return root_transitions[ch];
+    }
+#endif
+    int child = nodes[node_number].first_child;
+    while (child && txt[nodes[child].start] < ch) {
+        child = nodes[child].next_sibling;
+    }
+    return child && txt[nodes[child].start] == ch ? child : 0;
+}
+
+inline void SuffixTree::SetTransition(int node_number, int child) {
+    const char ch = txt[nodes[child].start];
+#ifdef SUFFIX_TREE_DENSE_ROOT
+    if (!node_number) {
+        root_transitions[ch] = child;
+        return;
+    }
+#endif
+    int* link = &nodes[node_number].first_child;
+    while (*link && txt[nodes[*link].start] < ch) {
+        link = &nodes[*link].next_sibling;
+    }
+    if (*link && txt[nodes[*link].start] == ch) {
+        nodes[child].next_sibling = nodes[*link].next_sibling;
+    } else {
+        nodes[child].next_sibling = *link;
+    }
+    *link = child;
+}
+
+inline int SuffixTree::Add(const Node& node) {
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+inline void SuffixTree::Insert(char ch) {
+    ++remainder;
+    last = -1;
+    while (remainder) {
+
+        if (!point.len) {
+            point.edge = position;
+        }
+
+        int next = Transition(point.node, txt[point.edge]);
+        if (!next) {  // Правило #2
+
+            SetTransition(point.node, Add(Node(position)));
+            AddSuffLink(point.node);
+
+        } else {
+
+            if (point.len >= nodes[next].edge_length(position)) {
+                Descent(next);
+                continue;
+            }
+
+            if (txt[nodes[next].start + point.len] == ch) {
+                if (point.node) {
+                    AddSuffLink(point.node);
+                }
+                ++point.len;
+                break;
+            }
+
+            // Строим развилку
+            const int split = Add(Node(nodes[next].start, nodes[next].start + point.len - 1));
+            SetTransition(point.node, split);
+            SetTransition(split, Add(Node(position)));
+
+            nodes[next].start += point.len;
+            SetTransition(split, next);
+
+            AddSuffLink(split, split);
+        }
+
+        --remainder;
+
+        if (!point.node && point.len) {               // Правило #1
+            --point.len;
+            point.edge = position - remainder + 1;
+        } else if (point.node) {                      // Правило #3
+            point.node = nodes[point.node].suff_link;
+        }
+    }
+}
+
+inline int SuffixTree::NodeCount() {
+    return nodes.size();
+}
+
+inline int SuffixTree::GetPosition() {
+    return position;
+}
+
+inline std::vector<std::array<int, 4>> SuffixTree::NodeData() const {
+    std::vector<std::array<int, 4>> data;
+    data.reserve(nodes.size() - 1);
+    EmitPreorder([&data](int parent, int string_number, int start, int end) {
+        data.push_back({parent, string_number, start, end});
+    });
+    return data;
+}
+
+template <class Sink>
+void SuffixTree::EmitPreorder(Sink&& sink) const {
+    struct Frame {
+        int node;
+        int parent;    // Номер родителя в порядке обхода
+    };
+    std::vector<Frame> stack;
+#ifdef SUFFIX_TREE_DENSE_ROOT
+    for (auto transition = root_transitions.rbegin(); transition != root_transitions.rend(); ++transition) {
+        if (*transition) {
+            stack.push_back({*transition, 0});
+        }
+    }
+#else
+    if (nodes[0].first_child) {
+        stack.push_back({nodes[0].first_child, 0});
+    }
+#endif
+    const int last_in_txt = static_cast<int>(txt.size()) - 1;
+    int counter = 0;
+    while (!stack.empty()) {
+        const Frame frame = stack.back();
+        stack.pop_back();
+        const Node& node = nodes[frame.node];
+        const int number = ++counter;
+        const int end = std::min(node.end, last_in_txt);
+
+        // Номер строки, в которой лежит ребро, и его границы в ней
+        if (node.start <= last_in_s) {
+            sink(frame.parent, 0, node.start, std::min(end, last_in_s));   // s
+        } else {
+            sink(frame.parent, 1, node.start - last_in_s - 1, end - last_in_s - 1);   // t
+        }
+
+        // Брат ждёт, пока не обойдено поддерево; у детей плотного корня братьев нет
+        if (node.next_sibling) {
+            stack.push_back({node.next_sibling, frame.parent});
+        }
+        if (node.first_child) {
+            stack.push_back({node.first_child, number});
+        }
+    }
+}
+
+inline void SuffixTree::PrepareQueries() {
+    struct Frame {
+        int node;
+        int depth;     // Строковая глубина родителя
+        bool leaving;
+    };
+    const int length = txt.size();
+    leaf_begin.assign(nodes.size(), 0);
+    leaf_end.assign(nodes.size(), 0);
+    leaves.clear();
+    leaves.reserve(length);
+    std::vector<Frame> stack = {{0, 0, false}};
+    while (!stack.empty()) {
+        const Frame frame = stack.back();
+        stack.pop_back();
+        const int node_number = frame.node;
+        if (frame.leaving) {
+            leaf_end[node_number] = leaves.size();
+            continue;
+        }
+        leaf_begin[node_number] = leaves.size();
+        const Node& node = nodes[node_number];
+        if (node_number && !node.first_child) {
+            leaves.push_back(node.start - frame.depth);
+            leaf_end[node_number] = leaves.size();
+            continue;
+        }
+        stack.push_back({node_number, 0, true});
+        const int depth = node_number ? frame.depth + std::min(node.end, length - 1) - node.start + 1 : 0;
+        // Дети кладутся в стек и разворачиваются, чтобы выходить по возрастанию символа
+        const size_t children_begin = stack.size();
+#ifdef SUFFIX_TREE_DENSE_ROOT
+        if (!node_number) {
+            for (int child : root_transitions) {
+                if (child) {
+                    stack.push_back({child, depth, false});
+                }
+            }
+        }
+#endif
+        for (int child = node.first_child; child; child = nodes[child].next_sibling) {
+            stack.push_back({child, depth, false});
+        }
+        std::reverse(stack.begin() + children_begin, stack.end());
+    }
+    if (leaves.size() != txt.size()) {
+        leaf_begin.clear();
+        leaf_end.clear();
+        leaves.clear();
+        throw std::logic_error("SuffixTree::PrepareQueries: text must end with a unique symbol");
+    }
+}
+
+inline SuffixTreeView SuffixTree::View() const {
+    if (leaf_begin.size() != nodes.size()) {
+        throw std::logic_error("SuffixTree::View: PrepareQueries was not called");
+    }
+#ifdef SUFFIX_TREE_DENSE_ROOT
+    const int* root_table = root_transitions.data();
+#else
+    const int* root_table = nullptr;
+#endif
+    return SuffixTreeView(nodes.data(), txt.data(), txt.size(), root_table,
+                          leaf_begin.data(), leaf_end.data(), leaves.data());
+}
+
+inline void SuffixTree::Save(const std::string& path) const {
+    if (leaf_begin.size() != nodes.size()) {
+        throw std::logic_error("SuffixTree::Save: PrepareQueries was not called");
+    }
+#ifdef SUFFIX_TREE_DENSE_ROOT
+    const bool has_root_table = true;
+    const int* root_table = root_transitions.data();
+#else
+    const bool has_root_table = false;
+    const int* root_table = nullptr;
+#endif
+    SuffixTreeFileHeader header{};
+    std::copy(SuffixTreeFileHeader::MAGIC, SuffixTreeFileHeader::MAGIC + sizeof(header.magic), header.magic);
+    header.version = SuffixTreeFileHeader::VERSION;
+    header.byte_order = SuffixTreeFileHeader::BYTE_ORDER_MARK;
+    header.node_size = sizeof(Node);
+    header.has_root_table = has_root_table;
+    header.length = txt.size();
+    header.nodes_count = nodes.size();
+    header.leaves_count = leaves.size();
+
+    uint64_t offset = sizeof(header);
+    auto section = [&offset](size_t bytes) {
+        offset = (offset + 7) / 8 * 8;
+        const uint64_t begin = offset;
+        offset += bytes;
+        return begin;
+    };
+    header.nodes_offset = section(nodes.size() * sizeof(Node));
+    header.txt_offset = section(txt.size());
+    header.leaf_begin_offset = section(leaf_begin.size() * sizeof(int));
+    header.leaf_end_offset = section(leaf_end.size() * sizeof(int));
+    header.leaves_offset = section(leaves.size() * sizeof(int));
+    header.root_table_offset = has_root_table ? section(ALPHASIZE * sizeof(int)) : 0;
+    header.file_size = offset;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("SuffixTree::Save: cannot open " + path);
+    }
+    uint64_t written = 0;
+    auto write = [&out, &written](uint64_t at, const void* data, size_t bytes) {
+        const char zeros[8] = {};
+        out.write(zeros, at - written);
+        out.write(static_cast<const char*>(data), bytes);
+        written = at + bytes;
+    };
+    write(0, &header, sizeof(header));
+    write(header.nodes_offset, nodes.data(), nodes.size() * sizeof(Node));
+    write(header.txt_offset, txt.data(), txt.size());
+    write(header.leaf_begin_offset, leaf_begin.data(), leaf_begin.size() * sizeof(int));
+    write(header.leaf_end_offset, leaf_end.data(), leaf_end.size() * sizeof(int));
+    write(header.leaves_offset, leaves.data(), leaves.size() * sizeof(int));
+    if (has_root_table) {
+        write(header.root_table_offset, root_table, ALPHASIZE * sizeof(int));
+    }
+    if (!out.flush()) {
+        throw std::runtime_error("SuffixTree::Save: cannot write " + path);
+    }
+}
+
+inline SuffixTreeView::SuffixTreeView(const SuffixTree::Node* nodes, const char* txt, int length,
+                                      const int* root_transitions, const int* leaf_begin, const int* leaf_end,
+                                      const int* leaves):
+        nodes(nodes), txt(txt), length(length), root_transitions(root_transitions),
+        leaf_begin(leaf_begin), leaf_end(leaf_end), leaves(leaves) {}
+
+inline int SuffixTreeView::Child(int node_number, char ch) const {
+    if (!node_number && root_transitions) {
+        return ch >= 0 && ch < ALPHASIZE ? root_transitions[static_cast<int>(ch)] : 0;
+    }
+    int child = nodes[node_number].first_child;
+    while (child && txt[nodes[child].start] < ch) {
+        child = nodes[child].next_sibling;
+    }
+    return child && txt[nodes[child].start] == ch ? child : 0;
+}
+
+inline int SuffixTreeView::Locus(std::string_view pattern) const {
+    int node_number = 0;
+    size_t matched = 0;
+    while (matched < pattern.length()) {
+        node_number = Child(node_number, pattern[matched]);
+        if (!node_number) {
+            return -1;
+        }
+        const int end = std::min(nodes[node_number].end, length - 1);
+        for (int pos = nodes[node_number].start; pos <= end && matched < pattern.length(); ++pos, ++matched) {
+            if (txt[pos] != pattern[matched]) {
+                return -1;
+            }
+        }
+    }
+    return node_number;
+}
+
+inline bool SuffixTreeView::Contains(std::string_view pattern) const {
+    return Locus(pattern) != -1;
+}
+
+inline int SuffixTreeView::Count(std::string_view pattern) const {
+    const int node_number = Locus(pattern);
+    return node_number == -1 ? 0 : leaf_end[node_number] - leaf_begin[node_number];
+}
+
+inline std::vector<int> SuffixTreeView::Locate(std::string_view pattern) const {
+    const int node_number = Locus(pattern);
+    if (node_number == -1) {
+        return {};
+    }
+    return std::vector<int>(leaves + leaf_begin[node_number], leaves + leaf_end[node_number]);
+}
+
+template <class Function>
+void SuffixTreeView::ForEachPattern(size_t patterns_count, size_t threads_count, Function&& function) const {
+    threads_count = std::max<size_t>(1, std::min(threads_count, patterns_count));
+    const size_t chunk = (patterns_count + threads_count - 1) / threads_count;
+    auto run = [&function, chunk, patterns_count](size_t t) {
+        for (size_t i = t * chunk; i < std::min(patterns_count, (t + 1) * chunk); ++i) {
+            function(i);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < threads_count; ++t) {
+        threads.emplace_back(run, t);
+    }
+    run(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+inline std::vector<int> SuffixTreeView::CountBatch(const std::vector<std::string>& patterns,
+                                                   size_t threads_count) const {
+    std::vector<int> counts(patterns.size());
+    ForEachPattern(patterns.size(), threads_count, [&](size_t i) { counts[i] = Count(patterns[i]); });
+    return counts;
+}
+
+inline std::vector<std::vector<int>> SuffixTreeView::LocateBatch(const std::vector<std::string>& patterns,
+                                                                 size_t threads_count) const {
+    std::vector<std::vector<int>> positions(patterns.size());
+    ForEachPattern(patterns.size(), threads_count, [&](size_t i) { positions[i] = Locate(patterns[i]); });
+    return positions;
+}
+
+#endif //SUFFIXTREE_SUFFIX_TREE_H
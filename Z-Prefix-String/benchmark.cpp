@@ -0,0 +1,228 @@
+/*
+ Переводы z <-> префикс-функция на массивах длины 10^7, построенных по периодическим строкам,
+ где z-блоки максимально перекрываются.
+ NestedPrefixFunctionFromZ - прежняя реализация с обратным проходом и break, для сравнения.
+ ScalarZFunction - z-функция с побайтным продлением, против CommonPrefixLength в ZFunctionFromString;
+ векторные ветки CommonPrefixLength включаются флагами сборки, например -march=native.
+ ParallelZFunctionFromString - по числу потоков, с проверкой совпадения с последовательной версией.
+ ZMatcher - потоковый поиск образца против z-функции склейки pattern$text.
+ Runs и LyndonFactorization на строках длины 10^6.
+ OnlineZPrefix::Append по символу на строках длины 10^6: пропускная способность против z-функции всей
+ строки разом и самое долгое Append (отдельным проходом с часами на каждый вызов, с ростом векторов);
+ a^(n-1)b - худший случай, последний символ закрывает n - 1 блоков.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "online_z_prefix.h"
+#include "parallel_z.h"
+#include "periodicity.h"
+#include "z_matcher.h"
+#include "z_prefix.h"
+
+const size_t LENGTH = 10000000;
+
+using Index = uint32_t;
+
+std::vector<Index> NestedPrefixFunctionFromZ(const std::vector<Index>& z_func) {
+    std::vector<Index> pref_func(z_func.size());
+    for (size_t i = 1; i < z_func.size(); ++i) {
+        for (long long j = static_cast<long long>(z_func[i]) - 1; j >= 0; --j) {
+            if (pref_func[i + j] > 0) {
+                break;
+            } else {
+                pref_func[i + j] = j + 1;
+            }
+        }
+    }
+    return pref_func;
+}
+
+std::vector<Index> ScalarZFunction(const std::string& str) {
+    std::vector<Index> z_func(str.length());
+    z_func[0] = str.length();
+    size_t left = 0;
+    size_t right = 0;
+    for (size_t i = 1; i < str.length(); ++i) {
+        if (i < right) {
+            z_func[i] = std::min<size_t>(right - i, z_func[i - left]);
+        }
+        while (i + z_func[i] < str.length() && str[z_func[i]] == str[i + z_func[i]]) {
+            ++z_func[i];
+        }
+        if (i + z_func[i] > right) {
+            left = i;
+            right = i + z_func[i];
+        }
+    }
+    return z_func;
+}
+
+template <class Function>
+double Milliseconds(Function&& function) {
+    auto begin = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - begin;
+    return time.count();
+}
+
+std::string Repeat(const std::string& period, size_t length) {
+    std::string result;
+    result.reserve(length);
+    while (result.length() < length) {
+        result += period;
+    }
+    result.resize(length);
+    return result;
+}
+
+std::string Fibonacci(size_t length) {
+    std::string prev = "a";
+    std::string current = "ab";
+    while (current.length() < length) {
+        std::string next = current + prev;
+        prev = std::move(current);
+        current = std::move(next);
+    }
+    current.resize(length);
+    return current;
+}
+
+void ReportCommonPrefix(size_t length) {
+    std::string first(length, 'a');
+    std::string second = first;
+    second.back() = 'b';
+    size_t scalar = 0;
+    double scalar_time = Milliseconds([&] {
+        while (scalar < length && first[scalar] == second[scalar]) {
+            ++scalar;
+        }
+    });
+    size_t simd = 0;
+    double simd_time = Milliseconds([&] { simd = CommonPrefixLength(first.data(), second.data(), length); });
+    printf("lcp of %zu bytes: scalar %6.2f ms, simd %6.2f ms%s\n",
+           length, scalar_time, simd_time, scalar == simd ? "" : " MISMATCH");
+}
+
+void Report(const char* name, const std::string& str) {
+    std::vector<Index> scalar_z_func;
+    std::vector<Index> z_func;
+    std::vector<Index> nested;
+    std::vector<Index> pref_func;
+    std::vector<Index> z_back;
+    double scalar_z_time = Milliseconds([&] { scalar_z_func = ScalarZFunction(str); });
+    double z_time = Milliseconds([&] { z_func = ZFunctionFromString<Index>(str); });
+    double nested_time = Milliseconds([&] { nested = NestedPrefixFunctionFromZ(z_func); });
+    double pref_time = Milliseconds([&] { pref_func = PrefixFunctionFromZ(z_func); });
+    double back_time = Milliseconds([&] { z_back = ZFunctionFromPrefix(pref_func); });
+    printf("%-10s z scalar: %6.1f ms, simd: %6.1f ms | z->pref nested: %6.1f ms, linear: %6.1f ms | "
+           "pref->z: %6.1f ms%s\n",
+           name, scalar_z_time, z_time, nested_time, pref_time, back_time,
+           scalar_z_func == z_func && nested == pref_func && z_back == z_func ? "" : " MISMATCH");
+}
+
+void ReportParallel(const char* name, const std::string& str) {
+    std::vector<Index> z_func;
+    double sequential_time = Milliseconds([&] { z_func = ZFunctionFromString<Index>(str); });
+    printf("%-10s parallel z: sequential %6.1f ms", name, sequential_time);
+    const size_t max_threads = std::max<size_t>(std::thread::hardware_concurrency(), 8);
+    for (size_t threads_count = 1; threads_count <= max_threads; threads_count *= 2) {
+        std::vector<Index> parallel;
+        double time = Milliseconds([&] { parallel = ParallelZFunctionFromString<Index>(str, threads_count); });
+        printf(" | %zu: %6.1f ms%s", threads_count, time, parallel == z_func ? "" : " MISMATCH");
+    }
+    printf("\n");
+}
+
+void ReportMatcher(const char* name, const std::string& pattern, const std::string& text) {
+    size_t concat_count = 0;
+    double concat_time = Milliseconds([&] {
+        auto z_func = ZFunctionFromString<Index>(pattern + '$' + text);
+        for (size_t i = pattern.length() + 1; i < z_func.size(); ++i) {
+            concat_count += z_func[i] == pattern.length();
+        }
+    });
+    size_t stream_count = 0;
+    double stream_time = Milliseconds([&] {
+        ZMatcher<Index> matcher(pattern);
+        auto on_length = [&](size_t, size_t length) { stream_count += length == pattern.length(); };
+        for (size_t i = 0; i < text.length(); i += 1 << 16) {
+            matcher.Feed(std::string_view(text).substr(i, 1 << 16), on_length);
+        }
+        matcher.Finish(on_length);
+    });
+    printf("%-10s pattern$text z: %6.1f ms | streaming: %6.1f ms, %zu matches%s\n",
+           name, concat_time, stream_time, stream_count, concat_count == stream_count ? "" : " MISMATCH");
+}
+
+void ReportRuns(const char* name, const std::string& str) {
+    std::vector<size_t> factors;
+    double lyndon_time = Milliseconds([&] { factors = LyndonFactorization(str); });
+    std::vector<Run> runs;
+    double runs_time = Milliseconds([&] { runs = Runs(str); });
+    printf("%-10s %zu chars: lyndon factorization %6.1f ms (%zu factors) | runs %7.1f ms, %5.0f ns/char "
+           "(%zu runs)\n", name, str.length(), lyndon_time, factors.size(), runs_time,
+           runs_time * 1e6 / str.length(), runs.size());
+}
+
+void ReportOnline(const char* name, const std::string& str) {
+    using Clock = std::chrono::steady_clock;
+    OnlineZPrefix<Index> online;
+    double online_time = Milliseconds([&] {
+        for (char ch : str) {
+            online.Append(ch);
+        }
+    });
+    OnlineZPrefix<Index> timed;
+    double max_append = 0;
+    for (char ch : str) {
+        auto append_begin = Clock::now();
+        timed.Append(ch);
+        std::chrono::duration<double, std::nano> append_time = Clock::now() - append_begin;
+        max_append = std::max(max_append, append_time.count());
+    }
+    std::vector<Index> z_func;
+    double offline_time = Milliseconds([&] { z_func = ZFunctionFromString<Index>(str); });
+    bool same = true;
+    for (size_t i = 0; i < str.length(); ++i) {
+        same &= online.ZValue(i) == z_func[i];
+    }
+    printf("%-10s online append: %6.1f ns/char, slowest append %9.0f ns | offline z: %6.1f ns/char%s\n",
+           name, online_time * 1e6 / str.length(), max_append, offline_time * 1e6 / str.length(),
+           same ? "" : " MISMATCH");
+}
+
+int main() {
+    std::mt19937 generator(1);
+    std::string random(LENGTH, 'a');
+    for (auto& ch : random) {
+        ch = static_cast<char>('a' + generator() % 2);
+    }
+
+    ReportCommonPrefix(LENGTH);
+    Report("a^n", std::string(LENGTH, 'a'));
+    Report("(a^7b)^n", Repeat("aaaaaaab", LENGTH));
+    Report("fibonacci", Fibonacci(LENGTH));
+    Report("random", random);
+    ReportParallel("a^n", std::string(LENGTH, 'a'));
+    ReportParallel("fibonacci", Fibonacci(LENGTH));
+    ReportParallel("random", random);
+    ReportMatcher("a^n", std::string(100, 'a'), std::string(LENGTH, 'a'));
+    ReportMatcher("fibonacci", Fibonacci(1000), Fibonacci(LENGTH));
+    ReportMatcher("random", random.substr(0, 16), random);
+    ReportOnline("a^(n-1)b", std::string(LENGTH / 10 - 1, 'a') + 'b');
+    ReportOnline("(a^7b)^n", Repeat("aaaaaaab", LENGTH / 10));
+    ReportOnline("fibonacci", Fibonacci(LENGTH / 10));
+    ReportOnline("random", random.substr(0, LENGTH / 10));
+    ReportRuns("(a^7b)^n", Repeat("aaaaaaab", LENGTH / 10));
+    ReportRuns("fibonacci", Fibonacci(LENGTH / 10));
+    ReportRuns("random", random.substr(0, LENGTH / 10));
+    return 0;
+}
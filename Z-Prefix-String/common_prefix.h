@@ -0,0 +1,70 @@
+#ifndef Z_PREFIX_STRING_COMMON_PREFIX_H
+#define Z_PREFIX_STRING_COMMON_PREFIX_H
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX512BW__) || defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/*
+ Длина общего префикса first[0..length) и second[0..length), т.е. LCP-продление.
+ Сравнивает по 64/32/16 байт за шаг (AVX-512BW/AVX2/SSE2, что доступно при сборке):
+ маска совпавших байтов, первый ноль в ней - count trailing zeros.
+ Хвост - по 8 байт через xor машинных слов, затем побайтно.
+ Читает только внутри [0, length) обоих указателей.
+ */
+inline size_t CommonPrefixLength(const char* first, const char* second, size_t length) {
+    if (!length || *first != *second) {  // В z-функции большинство продлений обрывается на первом байте
+        return 0;
+    }
+    size_t i = 0;
+#if defined(__AVX512BW__)
+    for (; i + 64 <= length; i += 64) {
+        const uint64_t equal = _mm512_cmpeq_epi8_mask(
+                _mm512_loadu_si512(reinterpret_cast<const void*>(first + i)),
+                _mm512_loadu_si512(reinterpret_cast<const void*>(second + i)));
+        if (~equal) {
+            return i + __builtin_ctzll(~equal);
+        }
+    }
+#elif defined(__AVX2__)
+    for (; i + 32 <= length; i += 32) {
+        const uint32_t equal = _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i))));
+        if (~equal) {
+            return i + __builtin_ctz(~equal);
+        }
+    }
+#elif defined(__SSE2__)
+    for (; i + 16 <= length; i += 16) {
+        const uint32_t equal = _mm_movemask_epi8(_mm_cmpeq_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i)),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i))));
+        if (equal != 0xffff) {
+            return i + __builtin_ctz(~equal);
+        }
+    }
+#endif
+    for (; i + 8 <= length; i += 8) {
+        uint64_t first_word;
+        uint64_t second_word;
+        memcpy(&first_word, first + i, 8);
+        memcpy(&second_word, second + i, 8);
+        if (first_word != second_word) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            return i + __builtin_ctzll(first_word ^ second_word) / 8;
+#else
+            return i + __builtin_clzll(first_word ^ second_word) / 8;
+#endif
+        }
+    }
+    while (i < length && first[i] == second[i]) {
+        ++i;
+    }
+    return i;
+}
+
+#endif //Z_PREFIX_STRING_COMMON_PREFIX_H
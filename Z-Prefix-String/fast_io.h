@@ -0,0 +1,182 @@
+#ifndef Z_PREFIX_STRING_FAST_IO_H
+#define Z_PREFIX_STRING_FAST_IO_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ Весь ввод одним куском: обычный файл отображается через mmap без копирования,
+ pipe или терминал вычитываются fread-ом в один буфер.
+ */
+class InputBuffer {
+public:
+    explicit InputBuffer(FILE* in);
+    InputBuffer(const InputBuffer&) = delete;
+    InputBuffer& operator=(const InputBuffer&) = delete;
+
+    const char* Data() const;
+    size_t Size() const;
+
+    ~InputBuffer();
+
+private:
+    const char* data;
+    size_t size;
+    bool mapped;
+    std::vector<char> buffer;
+};
+
+// Число десятичных чисел: любой символ кроме цифры - разделитель
+size_t CountDecimals(const char* data, size_t size);
+
+/*
+ Разбор count десятичных чисел в заранее выделенный вектор.
+ Цифры разбираются по 8 за раз (SWAR): в 64-битном слове маска нецифровых байтов
+ даёт длину числа, затем три умножения склеивают пары, четвёрки и восьмёрки цифр.
+ std::out_of_range, если число не помещается в Index: усекать его молча нельзя.
+ */
+template <class Index>
+std::vector<Index> ParseDecimals(const char* data, size_t size, size_t count);
+
+// Массив little-endian uint32, size / 4 элементов. std::invalid_argument, если size не кратен 4,
+// std::out_of_range, если значение не помещается в Index
+template <class Index>
+std::vector<Index> ParseLittleEndianUint32(const char* data, size_t size);
+
+inline InputBuffer::InputBuffer(FILE* in): data(nullptr), size(0), mapped(false), buffer() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct stat info;
+    const int descriptor = fileno(in);
+    if (!fstat(descriptor, &info) && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address != MAP_FAILED) {
+            data = static_cast<const char*>(address);
+            size = info.st_size;
+            mapped = true;
+            return;
+        }
+    }
+#endif
+    const size_t CHUNK = 1 << 20;
+    size_t read = 0;
+    do {
+        buffer.resize(size + CHUNK);
+        read = fread(buffer.data() + size, 1, CHUNK, in);
+        size += read;
+    } while (read == CHUNK);
+    buffer.resize(size);
+    data = buffer.data();
+}
+
+inline const char* InputBuffer::Data() const {
+    return data;
+}
+
+inline size_t InputBuffer::Size() const {
+    return size;
+}
+
+inline InputBuffer::~InputBuffer() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapped) {
+        munmap(const_cast<char*>(data), size);
+    }
+#endif
+}
+
+inline bool IsDigit(char ch) {
+    return static_cast<unsigned char>(ch - '0') < 10;
+}
+
+inline size_t CountDecimals(const char* data, size_t size) {
+    size_t count = 0;
+    bool previous_digit = false;
+    for (size_t i = 0; i < size; ++i) {
+        const bool digit = IsDigit(data[i]);
+        count += digit && !previous_digit;
+        previous_digit = digit;
+    }
+    return count;
+}
+
+template <class Index>
+std::vector<Index> ParseDecimals(const char* data, size_t size, size_t count) {
+    const uint64_t ZEROS = 0x3030303030303030;
+    std::vector<Index> values(count);
+    size_t pos = 0;
+    for (size_t idx = 0; idx < count; ++idx) {
+        while (!IsDigit(data[pos])) {
+            ++pos;
+        }
+        uint64_t value = 0;
+        bool overflow = false;
+        while (pos + 8 <= size) {
+            uint64_t chunk;
+            memcpy(&chunk, data + pos, 8);
+            chunk ^= ZEROS;  // Цифры превращаются в 0..9, всё остальное - в байты больше 9
+            const uint64_t non_digits = ((chunk + 0x7676767676767676) | chunk) & 0x8080808080808080;
+            const size_t digits = non_digits ? __builtin_ctzll(non_digits) / 8 : 8;
+            if (!digits) {
+                break;
+            }
+            // Лишние байты отрезаем, цифры сдвигаем в старшие байты: слева встают ведущие нули
+            chunk = digits == 8 ? chunk : (chunk << (8 * (8 - digits)));
+            chunk = (chunk * 10 + (chunk >> 8)) & 0x00ff00ff00ff00ff;
+            chunk = (chunk * 100 + (chunk >> 16)) & 0x0000ffff0000ffff;
+            chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000ffffffff;
+            uint64_t scale = 1;
+            for (size_t i = 0; i < digits; ++i) {
+                scale *= 10;
+            }
+            overflow |= __builtin_mul_overflow(value, scale, &value);
+            overflow |= __builtin_add_overflow(value, chunk, &value);
+            pos += digits;
+            if (digits < 8) {
+                break;
+            }
+        }
+        while (pos < size && IsDigit(data[pos])) {  // Хвост у самого конца ввода
+            overflow |= __builtin_mul_overflow(value, 10, &value);
+            overflow |= __builtin_add_overflow(value, uint64_t(data[pos++] - '0'), &value);
+        }
+        if (overflow || value > std::numeric_limits<Index>::max()) {
+            throw std::out_of_range("ParseDecimals: value #" + std::to_string(idx) +
+                                    " does not fit the index type");
+        }
+        values[idx] = value;
+    }
+    return values;
+}
+
+template <class Index>
+std::vector<Index> ParseLittleEndianUint32(const char* data, size_t size) {
+    if (size % 4) {
+        throw std::invalid_argument("ParseLittleEndianUint32: trailing partial record of " +
+                                    std::to_string(size % 4) + " bytes");
+    }
+    std::vector<Index> values(size / 4);
+    for (size_t i = 0; i < values.size(); ++i) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(data + 4 * i);
+        const uint32_t value = uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 |
+                               uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+        if (value > std::numeric_limits<Index>::max()) {
+            throw std::out_of_range("ParseLittleEndianUint32: value #" + std::to_string(i) +
+                                    " does not fit the index type");
+        }
+        values[i] = value;
+    }
+    return values;
+}
+
+#endif //Z_PREFIX_STRING_FAST_IO_H
@@ -6,88 +6,37 @@
  * Memory: O(n)
  */
 
-#include <iostream>
-#include <string>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
 #include <vector>
-#include <stack>
 
-std::vector<size_t> ZFunctionFromString(const std::string& str);
-
-std::vector<size_t> PrefixFunctionFromZ(const std::vector<size_t>& z_func);
-
-std::vector<char> StringFromPrefix(const std::vector<size_t>& prefix_func);
-
-int main() {
-    std::vector<size_t> z_func;
-    std::string input;
-    size_t val = 1;
-    while (std::cin >> val) {
-        z_func.push_back(val);
+#include "fast_io.h"
+#include "index_width.h"
+#include "z_prefix.h"
+
+// "--binary" - на входе little-endian uint32 вместо десятичного текста
+int main(int argc, char** argv) {
+    const bool binary = argc > 1 && !strcmp(argv[1], "--binary");
+    InputBuffer input(stdin);
+    const size_t count = binary ? input.Size() / 4 : CountDecimals(input.Data(), input.Size());
+
+    Reconstruction<char> result;
+    try {
+        result = DispatchIndexWidth(count, [&input, binary, count](auto index_tag) {
+            using Index = decltype(index_tag);
+            auto z_func = binary ? ParseLittleEndianUint32<Index>(input.Data(), input.Size()) :
+                                   ParseDecimals<Index>(input.Data(), input.Size(), count);
+            return ReconstructFromZ(z_func);
+        });
+    } catch (const std::logic_error& error) {  // Значение шире Index, обрезанная запись, мал алфавит
+        fprintf(stderr, "%s\n", error.what());
+        return 1;
     }
-
-    auto result = StringFromPrefix(PrefixFunctionFromZ(z_func));
-    for (size_t i = 0; i < result.size(); ++i) {
-        std::cout << result[i];
+    if (result.violation != std::string::npos) {
+        fprintf(stderr, "not a z-function: first violation at index %zu\n", result.violation);
+        return 1;
     }
+    fwrite(result.str.data(), 1, result.str.size(), stdout);
     return 0;
-}
-
-std::vector<size_t> ZFunctionFromString(const std::string& str) {
-    std::vector<size_t> z_func(str.length());
-    size_t left = 0;
-    size_t right = 0;
-    for (size_t i = 0; i < str.length(); ++i) {
-        z_func[i] = 0;
-        if (std::min(right - i, z_func[i - left]) > 0) {
-            z_func[i] = std::min(right - i, z_func[i - left]);
-        }
-        while (i + z_func[i] < str.length() && str[z_func[i]] == str[i + z_func[i]]) {
-            ++z_func[i];
-        }
-        if (i + z_func[i] > right) {
-            left = i;
-            right = i + z_func[i];
-        }
-    }
-    return z_func;
-}
-
-std::vector<size_t> PrefixFunctionFromZ(const std::vector<size_t>& z_func) {
-    std::vector<size_t> pref_func(z_func.size());
-    for (size_t i = 1; i < z_func.size(); ++i) {
-        for (long long j = z_func[i] - 1; j >= 0; --j) {
-            if (pref_func[i + j] > 0) {
-                break;
-            } else {
-                pref_func[i + j] = j + 1;
-            }
-        }
-    }
-    return pref_func;
-}
-
-std::vector<char> StringFromPrefix(const std::vector<size_t>& prefix_func) {
-    std::vector<char> vector_str(prefix_func.size());
-    std::stack<size_t> idx_stack;
-    vector_str[0] = 'a';
-    for (size_t i = 1; i < prefix_func.size(); ++i) {
-        if (prefix_func[i] == 0) {
-            size_t idx = i - 1;
-            while (prefix_func[idx] != 0) {
-                idx_stack.push(prefix_func[idx]);
-                idx = prefix_func[idx] - 1;
-            }
-            char next_char = 'b';  // Очевидно не 'a'
-            while (!idx_stack.empty()) {
-                while (next_char == vector_str[idx_stack.top()]) {
-                    ++next_char;  // Используем расположение в мин л-граф порядке в таблице символов
-                }
-                idx_stack.pop();
-            }
-            vector_str[i] = next_char;
-        } else {
-            vector_str[i] = vector_str[prefix_func[i] - 1];
-        }
-    }
-    return vector_str;
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#ifndef Z_PREFIX_STRING_ONLINE_Z_PREFIX_H
+#define Z_PREFIX_STRING_ONLINE_Z_PREFIX_H
+
+#include <limits>
+#include <string>
+#include <vector>
+
+/*
+ Префикс-функция и z-функция растущей строки, символы добавляются по одному через Append.
+ Незакрытые z-блоки - это ровно границы текущей строки: z[n - k] для границы k ещё продлевается.
+ При добавлении c закрываются границы k с s[k] != c. Чтобы не перебирать остальные,
+ diff_link[k] прыгает к следующей границе в цепочке с другим следующим символом.
+ Каждая позиция закрывается один раз, поэтому Append амортизированно O(1).
+ Time: O(1) amortized per Append, O(1) per query
+ Memory: O(n)
+ */
+template <class Index = size_t>
+class OnlineZPrefix {
+public:
+    OnlineZPrefix();
+
+    void Append(char ch);
+
+    size_t Length() const;
+
+    // Длина наибольшей собственной границы - самый длинный ещё продлеваемый z-блок
+    size_t Border() const;
+
+    size_t SmallestPeriod() const;
+
+    size_t PrefixValue(size_t i) const;
+
+    size_t ZValue(size_t i) const;
+
+    ~OnlineZPrefix() = default;
+
+private:
+    static constexpr Index NONE = std::numeric_limits<Index>::max();
+
+    std::string str;
+    std::vector<Index> prefix_func;
+    std::vector<Index> diff_link;
+    std::vector<Index> z_func;  // NONE - блок ещё открыт, z = n - i
+};
+
+template <class Index>
+OnlineZPrefix<Index>::OnlineZPrefix(): str(), prefix_func(), diff_link(), z_func() {}
+
+template <class Index>
+void OnlineZPrefix<Index>::Append(char ch) {
+    const size_t length = str.length();
+    z_func.push_back(NONE);  // Позиция length - пустая граница, её блок тоже пока открыт
+    // Закрываем z-блоки границ, которые не продолжаются символом ch
+    size_t border = length ? prefix_func[length - 1] : NONE;
+    while (border != NONE) {
+        if (str[border] != ch) {
+            z_func[length - border] = border;
+            border = border ? prefix_func[border - 1] : NONE;
+        } else {
+            border = diff_link[border];
+        }
+    }
+
+    size_t prefix_length = length ? prefix_func[length - 1] : 0;
+    while (prefix_length > 0 && str[prefix_length] != ch) {
+        prefix_length = prefix_func[prefix_length - 1];
+    }
+    if (length && str[prefix_length] == ch) {
+        ++prefix_length;
+    }
+
+    str.push_back(ch);
+    prefix_func.push_back(prefix_length);
+    if (!length) {
+        diff_link.push_back(NONE);
+        return;
+    }
+    // Границы s[0..length) с тем же следующим символом, что и у length, пропускаем
+    const size_t previous = prefix_func[length - 1];
+    if (str[previous] != ch) {
+        diff_link.push_back(previous);
+    } else {
+        diff_link.push_back(previous ? diff_link[previous] : NONE);
+    }
+}
+
+template <class Index>
+size_t OnlineZPrefix<Index>::Length() const {
+    return str.length();
+}
+
+template <class Index>
+size_t OnlineZPrefix<Index>::Border() const {
+    return str.empty() ? 0 : prefix_func.back();
+}
+
+template <class Index>
+size_t OnlineZPrefix<Index>::SmallestPeriod() const {
+    return str.length() - Border();
+}
+
+template <class Index>
+size_t OnlineZPrefix<Index>::PrefixValue(size_t i) const {
+    return prefix_func[i];
+}
+
+template <class Index>
+size_t OnlineZPrefix<Index>::ZValue(size_t i) const {
+    return z_func[i] == NONE ? str.length() - i : z_func[i];
+}
+
+#endif //Z_PREFIX_STRING_ONLINE_Z_PREFIX_H
@@ -0,0 +1,204 @@
+#ifndef Z_PREFIX_STRING_PARALLEL_Z_H
+#define Z_PREFIX_STRING_PARALLEL_Z_H
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common_prefix.h"
+#include "z_prefix.h"
+
+/*
+ Z-функция по блокам в threads_count потоков, результат совпадает с ZFunctionFromString.
+ Блоков около 8 * threads_count, B = n / (8 * threads_count).
+ 1. Пролог: обычный алгоритм на префиксе длины 2B + 1 - даёт z[0..B) с точностью до B
+    и заодно обрабатывает первый блок; последовательно считается только n / (4 * threads_count).
+ 2. Параллельно: threads_count исполнителей, включая вызывающий поток, разбирают блоки по счётчику.
+    Каждый блок [begin, end) считается обычным алгоритмом, но продление обрезано на end,
+    т.е. получается min(z[i], end - i). Z-блок не выходит за [begin, end), поэтому копируемое значение
+    z[i - left] берётся из пролога, где оно уже точно до B.
+    "Открытые" позиции (z упёрлось в конец блока) не хранятся: после первой из них p локальный
+    z-блок - это [p, end), и остальные открытые позиции блока - ровно те j > p, где z[j] = end - j.
+ 3. Сверка по порядку блоков, последовательно: первый блок целиком, в остальных - только p.
+    z[p] копируется из глобального z-блока [left, right); если z[p - left] - ещё не сверенная
+    открытая позиция x блока b, её значение выводится из z-блока [p_b, p_b + z[p_b]) и z[x - p_b]
+    из пролога, т.е. за O(1) без прохода по блоку b.
+ 4. Параллельно: остальные открытые позиции каждого блока достраиваются от z-блока [p, p + z[p]),
+    копируемые значения снова лежат в прологе, так что блоки друг от друга не зависят.
+ На a^n последовательная часть - пролог и O(1) на блок.
+ Time: O(n / threads_count) + O(продлений за концы блоков)
+ Memory: O(n) на результат, O(threads_count) сверх него
+ */
+template <class Index = size_t>
+std::vector<Index> ParallelZFunctionFromString(const std::string& str,
+                                               size_t threads_count = std::thread::hardware_concurrency());
+
+template <class Index>
+std::vector<Index> ParallelZFunctionFromString(const std::string& str, size_t threads_count) {
+    const size_t length = str.length();
+    threads_count = std::max<size_t>(threads_count, 1);
+    const size_t block = (length + 8 * threads_count - 1) / (8 * threads_count);
+    if (threads_count == 1 || block < 2) {
+        return ZFunctionFromString<Index>(str);
+    }
+
+    std::vector<Index> z_func(length);
+    const char* data = str.data();
+    const size_t NONE = std::string::npos;
+
+    struct Block {
+        size_t begin;
+        size_t end;
+        size_t first_open;  // Первая позиция с z[i] = end - i < n - i или NONE
+        size_t left;        // Самый дальний z-блок среди закрытых позиций до first_open
+        size_t right;
+    };
+    std::vector<Block> blocks;
+    blocks.push_back({1, std::min(length, 2 * block + 1), NONE, 0, 0});
+    for (size_t begin = blocks[0].end; begin < length; begin += block) {
+        blocks.push_back({begin, std::min(length, begin + block), NONE, 0, 0});
+    }
+    auto is_open = [&](const Block& current, size_t i) {
+        return current.end < length && i + z_func[i] == current.end;
+    };
+
+    auto process = [&](Block& current) {
+        size_t left = 0;
+        size_t right = 0;
+        for (size_t i = current.begin; i < current.end; ++i) {
+            size_t value = 0;
+            if (i < right) {
+                value = std::min<size_t>(right - i, z_func[i - left]);
+            }
+            value += CommonPrefixLength(data + value, data + i + value, current.end - i - value);
+            z_func[i] = value;
+            if (current.first_open == NONE) {
+                if (is_open(current, i)) {
+                    current.first_open = i;
+                } else if (i + value > current.right) {
+                    current.left = i;
+                    current.right = i + value;
+                }
+            }
+            if (i + value > right) {
+                left = i;
+                right = i + value;
+            }
+        }
+    };
+
+    // Блоки разного веса (открытые позиции, длина продлений), поэтому раздаются по одному
+    auto for_each_block = [&](auto&& action) {
+        std::atomic<size_t> next_block(1);
+        auto work = [&] {
+            for (size_t k = next_block++; k < blocks.size(); k = next_block++) {
+                action(blocks[k]);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < std::min(threads_count, blocks.size() - 1); ++t) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    };
+
+    // Пролог: первый блок вместе с префиксом, z[j] для j < B точны хотя бы до B
+    z_func[0] = length;
+    process(blocks[0]);
+    for_each_block(process);
+
+    // z[i] по z-блоку [left, right), в котором лежит i: copied - z[i - left] (exact) или нижняя граница
+    // для него, known - уже известная нижняя граница z[i]. Продление - только если блока не хватило
+    auto extend = [&](size_t i, size_t right, size_t copied, bool exact, size_t known) {
+        if (copied != right - i && (exact || copied > right - i)) {
+            return std::min<size_t>(copied, right - i);
+        }
+        known = std::max<size_t>(known, std::min<size_t>(copied, right - i));
+        return known + CommonPrefixLength(data + known, data + i + known, length - i - known);
+    };
+
+    // Сверка первого блока целиком: позиции до i уже окончательны, как в последовательном алгоритме
+    size_t left = blocks[0].left;
+    size_t right = blocks[0].right;
+    for (size_t i = blocks[0].first_open; i < blocks[0].end && i != NONE; ++i) {
+        if (!is_open(blocks[0], i)) {
+            continue;
+        }
+        const size_t known = blocks[0].end - i;
+        z_func[i] = i < right ? extend(i, right, z_func[i - left], true, known) :
+                                extend(i, i, 0, false, known);
+        if (i + z_func[i] > right) {
+            left = i;
+            right = i + z_func[i];
+        }
+    }
+
+    // Сверка первых открытых позиций. Окончательны пролог, закрытые позиции и p уже пройденных блоков;
+    // про открытую x блока b известно z[x] = min(z[x - p_b], z[p_b] - (x - p_b)), если они различны,
+    // иначе только z[x] >= z[p_b] - (x - p_b)
+    auto settled = [&](size_t x, size_t& value) {
+        if (x < blocks[0].end) {
+            value = z_func[x];
+            return true;
+        }
+        const Block& owner = blocks[1 + (x - blocks[0].end) / block];
+        if (owner.first_open == NONE || x <= owner.first_open || !is_open(owner, x)) {
+            value = z_func[x];
+            return true;
+        }
+        const size_t shift = x - owner.first_open;
+        const size_t bound = z_func[owner.first_open] - shift;
+        value = std::min<size_t>(z_func[shift], bound);
+        return z_func[shift] != bound;
+    };
+    for (size_t k = 1; k < blocks.size(); ++k) {
+        Block& current = blocks[k];
+        if (current.right > right) {
+            left = current.left;
+            right = current.right;
+        }
+        const size_t i = current.first_open;
+        if (i == NONE) {
+            continue;
+        }
+        const size_t known = current.end - i;
+        if (i < right) {
+            size_t copied = 0;
+            const bool exact = settled(i - left, copied);
+            z_func[i] = extend(i, right, copied, exact, known);
+        } else {
+            z_func[i] = extend(i, i, 0, false, known);
+        }
+        if (i + z_func[i] > right) {
+            left = i;
+            right = i + z_func[i];
+        }
+    }
+
+    // Остальные открытые позиции: локальный z-блок начинается не раньше p, копии берутся из пролога
+    for_each_block([&](const Block& current) {
+        if (current.first_open == NONE) {
+            return;
+        }
+        size_t left = current.first_open;
+        size_t right = left + z_func[left];
+        for (size_t i = left + 1; i < current.end; ++i) {
+            if (!is_open(current, i)) {
+                continue;
+            }
+            z_func[i] = extend(i, right, z_func[i - left], true, current.end - i);
+            if (i + z_func[i] > right) {
+                left = i;
+                right = i + z_func[i];
+            }
+        }
+    });
+    return z_func;
+}
+
+#endif //Z_PREFIX_STRING_PARALLEL_Z_H
@@ -0,0 +1,243 @@
+#ifndef Z_PREFIX_STRING_PERIODICITY_H
+#define Z_PREFIX_STRING_PERIODICITY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "suffix_array.h"
+#include "z_prefix.h"
+
+/*
+ Периодичность строки:
+ AllPeriods - все периоды по возрастанию, p - период <=> z[p] = n - p. Time: O(n)
+ LyndonFactorization - начала слов Линдона в разложении Дюваля. Time: O(n), Memory: O(1) доп.
+ Runs - все максимальные повторы (runs) через корни Линдона; сравнения суффиксов и продления -
+     точные, по суффиксным массивам строки, её обращения и строки с обращённым алфавитом.
+     Time: O(n) + сортировка найденных повторов
+ */
+
+struct Run {  // [start, end), период period, end - start >= 2 * period
+    size_t start;
+    size_t end;
+    size_t period;
+
+    bool operator == (const Run& rhv) const {
+        return start == rhv.start && end == rhv.end && period == rhv.period;
+    }
+
+    bool operator < (const Run& rhv) const {
+        return std::tie(start, end, period) < std::tie(rhv.start, rhv.end, rhv.period);
+    }
+};
+
+std::vector<size_t> AllPeriods(const std::string& str);
+
+std::vector<size_t> LyndonFactorization(const std::string& str);
+
+std::vector<Run> Runs(const std::string& str);
+
+inline std::vector<size_t> AllPeriods(const std::string& str) {
+    std::vector<size_t> periods;
+    auto z_func = ZFunctionFromString(str);
+    for (size_t period = 1; period < str.length(); ++period) {
+        if (period + z_func[period] == str.length()) {
+            periods.push_back(period);
+        }
+    }
+    if (!str.empty()) {
+        periods.push_back(str.length());
+    }
+    return periods;
+}
+
+inline std::vector<size_t> LyndonFactorization(const std::string& str) {
+    std::vector<size_t> starts;
+    size_t i = 0;
+    while (i < str.length()) {
+        size_t j = i + 1;
+        size_t k = i;
+        while (j < str.length() && str[k] <= str[j]) {
+            k = str[k] < str[j] ? i : k + 1;
+            ++j;
+        }
+        while (i <= k) {  // Префикс - степень слова Линдона длины j - k
+            starts.push_back(i);
+            i += j - k;
+        }
+    }
+    return starts;
+}
+
+// Минимум на отрезке за O(1) после O(n) подготовки. Блоки по 64: внутри блока mask[i] - биты стека
+// суффиксных минимумов блока до i, первый бит стека не левее left - минимум на [left, i];
+// между блоками - разреженная таблица минимумов блоков, (n / 64) log n
+template <class Value>
+class RangeMin {
+public:
+    explicit RangeMin(const std::vector<Value>& values);
+
+    // Минимум на [left, right], left <= right
+    Value Min(size_t left, size_t right) const;
+
+    ~RangeMin() = default;
+
+private:
+    static constexpr size_t BLOCK = 64;
+
+    Value InBlock(size_t left, size_t right) const;
+
+    const std::vector<Value>& values;
+    std::vector<uint64_t> mask;
+    std::vector<std::vector<Value>> sparse;  // sparse[k][b] - минимум блоков [b, b + 2^k)
+};
+
+template <class Value>
+RangeMin<Value>::RangeMin(const std::vector<Value>& values): values(values), mask(values.size()), sparse() {
+    const size_t blocks = (values.size() + BLOCK - 1) / BLOCK;
+    sparse.emplace_back(blocks);
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t begin = block * BLOCK;
+        const size_t end = std::min(values.size(), begin + BLOCK);
+        uint64_t stack = 0;
+        for (size_t i = begin; i < end; ++i) {
+            while (stack && values[begin + 63 - __builtin_clzll(stack)] >= values[i]) {
+                stack &= ~(uint64_t(1) << (63 - __builtin_clzll(stack)));
+            }
+            stack |= uint64_t(1) << (i - begin);
+            mask[i] = stack;
+        }
+        sparse[0][block] = values[begin + __builtin_ctzll(mask[end - 1])];
+    }
+    for (size_t k = 1; (size_t(1) << k) <= blocks; ++k) {
+        const size_t half = size_t(1) << (k - 1);
+        sparse.emplace_back(blocks - 2 * half + 1);
+        for (size_t block = 0; block + 2 * half <= blocks; ++block) {
+            sparse[k][block] = std::min(sparse[k - 1][block], sparse[k - 1][block + half]);
+        }
+    }
+}
+
+template <class Value>
+Value RangeMin<Value>::InBlock(size_t left, size_t right) const {
+    const size_t begin = left / BLOCK * BLOCK;
+    return values[begin + __builtin_ctzll(mask[right] & (~uint64_t(0) << (left - begin)))];
+}
+
+template <class Value>
+Value RangeMin<Value>::Min(size_t left, size_t right) const {
+    const size_t left_block = left / BLOCK;
+    const size_t right_block = right / BLOCK;
+    if (left_block == right_block) {
+        return InBlock(left, right);
+    }
+    Value result = std::min(InBlock(left, left_block * BLOCK + BLOCK - 1), InBlock(right_block * BLOCK, right));
+    if (left_block + 1 < right_block) {
+        const size_t k = 63 - __builtin_clzll(right_block - left_block - 1);
+        result = std::min({result, sparse[k][left_block + 1], sparse[k][right_block - (size_t(1) << k)]});
+    }
+    return result;
+}
+
+// Точное LCE суффиксов: суффиксный массив SA-IS, LCP Касаи и RangeMin по LCP. Time: O(n), O(1) на запрос
+class SuffixLce {
+public:
+    explicit SuffixLce(const std::string& str);
+
+    SuffixLce(const SuffixLce&) = delete;
+    SuffixLce& operator = (const SuffixLce&) = delete;
+
+    // Длина общего префикса суффиксов first и second
+    size_t Lce(size_t first, size_t second) const;
+
+    // Место суффикса в лексикографическом порядке
+    size_t Rank(size_t pos) const;
+
+    ~SuffixLce() = default;
+
+private:
+    SuffixLce(const std::string& str, const std::vector<uint32_t>& suffix_array);
+
+    std::vector<uint32_t> rank;
+    std::vector<uint32_t> lcp;
+    RangeMin<uint32_t> range_min;
+};
+
+inline SuffixLce::SuffixLce(const std::string& str): SuffixLce(str, SuffixArray<uint32_t>(str)) {}
+
+inline SuffixLce::SuffixLce(const std::string& str, const std::vector<uint32_t>& suffix_array):
+        rank(str.length()), lcp(LcpArray(str, suffix_array)), range_min(lcp) {
+    for (size_t r = 0; r < suffix_array.size(); ++r) {
+        rank[suffix_array[r]] = r;
+    }
+}
+
+inline size_t SuffixLce::Lce(size_t first, size_t second) const {
+    if (first == second) {
+        return rank.size() - first;
+    }
+    const auto [low, high] = std::minmax(rank[first], rank[second]);
+    return range_min.Min(low + 1, high);
+}
+
+inline size_t SuffixLce::Rank(size_t pos) const {
+    return rank[pos];
+}
+
+inline std::vector<Run> Runs(const std::string& str) {
+    const size_t length = str.length();
+    std::string reversed(str.rbegin(), str.rend());
+    std::string inverted_str(str);
+    for (auto& ch : inverted_str) {
+        ch = static_cast<char>(255 - static_cast<unsigned char>(ch));
+    }
+    const SuffixLce forward(str);
+    const SuffixLce backward(reversed);
+    // Ранги суффиксов при обращённом алфавите; конец строки по-прежнему меньше любого символа
+    std::vector<uint32_t> inverted_rank(length);
+    const auto inverted_suffix_array = SuffixArray<uint32_t>(inverted_str);
+    for (size_t r = 0; r < length; ++r) {
+        inverted_rank[inverted_suffix_array[r]] = r;
+    }
+    // Общий суффикс префиксов str[0..first) и str[0..second) - общий префикс суффиксов reversed
+    auto backward_lce = [&](size_t first, size_t second) {
+        return std::min(first, second) ? backward.Lce(length - first, length - second) : 0;
+    };
+    std::vector<Run> runs;
+    std::vector<size_t> lyndon(length);
+
+    // Теорема о runs: у каждого повтора есть корень Линдона в одном из двух порядков алфавита,
+    // и это самое длинное слово Линдона, начинающееся в его позиции
+    for (bool inverted : {false, true}) {
+        auto suffix_less = [&](size_t first, size_t second) {
+            return inverted ? inverted_rank[first] < inverted_rank[second] : forward.Rank(first) < forward.Rank(second);
+        };
+        // Массив Линдона: следующий меньший суффикс справа, переходы по уже посчитанным словам
+        for (size_t i = length; i-- > 0;) {
+            size_t next = i + 1;
+            while (next < length && suffix_less(i, next)) {
+                next += lyndon[next];
+            }
+            lyndon[i] = next - i;
+        }
+        for (size_t i = 0; i < length; ++i) {
+            const size_t period = lyndon[i];
+            if (i + period >= length) {
+                continue;
+            }
+            const size_t end = i + period + forward.Lce(i, i + period);
+            const size_t start = i - backward_lce(i, i + period);
+            if (end - start >= 2 * period) {
+                runs.push_back({start, end, period});
+            }
+        }
+    }
+
+    std::sort(runs.begin(), runs.end());
+    runs.erase(std::unique(runs.begin(), runs.end()), runs.end());
+    return runs;
+}
+
+#endif //Z_PREFIX_STRING_PERIODICITY_H
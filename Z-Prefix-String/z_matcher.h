@@ -0,0 +1,104 @@
+#ifndef Z_PREFIX_STRING_Z_MATCHER_H
+#define Z_PREFIX_STRING_Z_MATCHER_H
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "z_prefix.h"
+
+/*
+ Поиск образца по z-функции без склейки pattern$text: хранится только z-функция образца.
+ Для каждой позиции текста j считается длина совпадения с образцом ext[j] = LCP(text[j..], pattern).
+ Текст подаётся кусками через Feed и нигде не запоминается: окно [left, right) - самое левое
+ незакрытое совпадение, text[left..right) = pattern[0..right - left).
+ Позиции внутри окна с z[j - left] < right - j закрываются сразу по z-функции образца,
+ остальные ждут следующих символов. Позиции отдаются строго по возрастанию, каждая один раз.
+ on_length(position, length) вызывается для каждой закрытой позиции, length == PatternLength() - вхождение.
+ Time: O(m) preprocessing, O(1) amortized per text char
+ Memory: O(m)
+ */
+template <class Index = size_t>
+class ZMatcher {
+public:
+    explicit ZMatcher(const std::string& pattern);
+
+    template <class Callback>
+    void Feed(std::string_view text, Callback&& on_length);
+
+    // Конец текста: незакрытые позиции получают длину до конца текста
+    template <class Callback>
+    void Finish(Callback&& on_length);
+
+    size_t PatternLength() const;
+
+    // Сколько символов текста подано
+    size_t Position() const;
+
+    ~ZMatcher() = default;
+
+private:
+    // Закрывает left и все позиции окна до следующей незакрытой
+    template <class Callback>
+    void CloseLeft(Callback&& on_length);
+
+    std::string pattern;
+    std::vector<Index> z_func;
+    size_t left;
+    size_t right;
+};
+
+template <class Index>
+ZMatcher<Index>::ZMatcher(const std::string& pattern):
+        pattern(pattern), z_func(ZFunctionFromString<Index>(pattern)), left(0), right(0) {}
+
+template <class Index>
+template <class Callback>
+void ZMatcher<Index>::Feed(std::string_view text, Callback&& on_length) {
+    for (char ch : text) {
+        while (left < right) {
+            if (right - left < pattern.length() && pattern[right - left] == ch) {
+                break;
+            }
+            CloseLeft(on_length);
+        }
+        if (left == right && (pattern.empty() || pattern[0] != ch)) {
+            on_length(left, size_t(0));
+            ++left;
+        }
+        ++right;
+    }
+}
+
+template <class Index>
+template <class Callback>
+void ZMatcher<Index>::Finish(Callback&& on_length) {
+    while (left < right) {
+        CloseLeft(on_length);
+    }
+}
+
+template <class Index>
+template <class Callback>
+void ZMatcher<Index>::CloseLeft(Callback&& on_length) {
+    const size_t start = left;
+    on_length(start, right - start);
+    ++left;
+    while (left < right && z_func[left - start] < right - left) {
+        on_length(left, size_t(z_func[left - start]));
+        ++left;
+    }
+}
+
+template <class Index>
+size_t ZMatcher<Index>::PatternLength() const {
+    return pattern.length();
+}
+
+template <class Index>
+size_t ZMatcher<Index>::Position() const {
+    return right;
+}
+
+#endif //Z_PREFIX_STRING_Z_MATCHER_H
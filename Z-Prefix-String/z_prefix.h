@@ -0,0 +1,228 @@
+#ifndef Z_PREFIX_STRING_Z_PREFIX_H
+#define Z_PREFIX_STRING_Z_PREFIX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common_prefix.h"
+
+/*
+ Z-функция строки, линейные переводы z-функция <-> префикс-функция
+ и восстановление лексикографически минимальной строки по префикс-функции.
+ Index - тип элементов массивов, должен вмещать длину строки (см. DispatchIndexWidth).
+ z[0] считается равным длине строки, как в ZFunctionFromString.
+ Time: O(n) each
+ Memory: O(n)
+ */
+
+template <class Index = size_t>
+std::vector<Index> ZFunctionFromString(const std::string& str);
+
+template <class Index>
+std::vector<Index> PrefixFunctionFromZ(const std::vector<Index>& z_func);
+
+template <class Index>
+std::vector<Index> ZFunctionFromPrefix(const std::vector<Index>& prefix_func);
+
+// Строка, восстановленная по массиву, и первый индекс, на котором массив перестаёт быть
+// префикс-функцией (z-функцией), или std::string::npos. При нарушении верен только префикс строки до него
+template <class Char>
+struct Reconstruction {
+    std::vector<Char> str;
+    size_t violation;
+};
+
+// Алфавит - alphabet_size символов подряд начиная с base; std::out_of_range, если их не хватило.
+// Проверка идёт в том же проходе, что и восстановление
+template <class Index, class Char = char>
+Reconstruction<Char> ReconstructFromPrefix(const std::vector<Index>& prefix_func,
+                                           Char base = 'a', size_t alphabet_size = 26);
+
+// z[0] может быть 0 или n
+template <class Index, class Char = char>
+Reconstruction<Char> ReconstructFromZ(const std::vector<Index>& z_func,
+                                      Char base = 'a', size_t alphabet_size = 26);
+
+// То же, но std::invalid_argument, если массив не префикс-функция
+template <class Index, class Char = char>
+std::vector<Char> StringFromPrefix(const std::vector<Index>& prefix_func,
+                                   Char base = 'a', size_t alphabet_size = 26);
+
+template <class Index>
+std::vector<Index> ZFunctionFromString(const std::string& str) {
+    std::vector<Index> z_func(str.length());
+    if (str.empty()) {
+        return z_func;
+    }
+    z_func[0] = str.length();  // Блок [0, n) в окно не берём, иначе z[i - left] ссылается на само z[i]
+    size_t left = 0;
+    size_t right = 0;
+    for (size_t i = 1; i < str.length(); ++i) {
+        z_func[i] = 0;
+        if (i < right && std::min<size_t>(right - i, z_func[i - left]) > 0) {
+            z_func[i] = std::min<size_t>(right - i, z_func[i - left]);
+        }
+        z_func[i] += CommonPrefixLength(str.data() + z_func[i], str.data() + i + z_func[i],
+                                        str.length() - i - z_func[i]);
+        if (i + z_func[i] > right) {
+            left = i;
+            right = i + z_func[i];
+        }
+    }
+    return z_func;
+}
+
+template <class Index>
+std::vector<Index> PrefixFunctionFromZ(const std::vector<Index>& z_func) {
+    // pref[j] задаёт самый левый z-блок, накрывающий j, поэтому каждый j пишется ровно один раз:
+    // блоки с меньшим началом уже заполнили [i, filled)
+    const size_t length = z_func.size();
+    std::vector<Index> pref_func(length);
+    size_t filled = 1;
+    for (size_t i = 1; i < length; ++i) {
+        const size_t block_end = std::min<size_t>(length, i + z_func[i]);
+        for (size_t j = std::max(filled, i); j < block_end; ++j) {
+            pref_func[j] = j - i + 1;
+        }
+        filled = std::max(filled, block_end);
+    }
+    return pref_func;
+}
+
+template <class Index>
+std::vector<Index> ZFunctionFromPrefix(const std::vector<Index>& prefix_func) {
+    const size_t length = prefix_func.size();
+    std::vector<Index> z_func(length);
+    if (!length) {
+        return z_func;
+    }
+    z_func[0] = length;
+    // Граница pref[i] даёт z-блок длины pref[i] в позиции i - pref[i] + 1
+    for (size_t i = 1; i < length; ++i) {
+        if (prefix_func[i]) {
+            z_func[i - prefix_func[i] + 1] = prefix_func[i];
+        }
+    }
+    // Остальное копируется внутри z-блоков, каждая позиция посещается один раз
+    size_t i = 1;
+    while (i < length) {
+        size_t last = i;
+        if (z_func[i]) {
+            for (size_t j = 1; j < z_func[i] && z_func[i + j] <= z_func[j]; ++j) {
+                z_func[i + j] = std::min<size_t>(z_func[j], z_func[i] - j);
+                last = i + j;
+            }
+        }
+        i = last + 1;
+    }
+    return z_func;
+}
+
+template <class Index, class Char>
+Reconstruction<Char> ReconstructFromPrefix(const std::vector<Index>& prefix_func,
+                                           Char base, size_t alphabet_size) {
+    Reconstruction<Char> result{std::vector<Char>(prefix_func.size(), base), std::string::npos};
+    std::vector<Char>& vector_str = result.str;
+    if (prefix_func.empty()) {
+        return result;
+    }
+    if (prefix_func[0]) {
+        result.violation = 0;
+        return result;
+    }
+    // Одна битовая маска запрещённых символов на весь проход, после каждой позиции биты снимаются обратно
+    std::vector<uint64_t> forbidden((alphabet_size + 63) / 64);
+    auto mark_border_chars = [&](size_t i, bool value) {
+        // s[k] продолжил бы границу длины k: нулевую и все границы s[0..i)
+        size_t k = prefix_func[i - 1];
+        while (true) {
+            const size_t ch = vector_str[k] - base;
+            if (value) {
+                forbidden[ch / 64] |= uint64_t(1) << (ch % 64);
+            } else {
+                forbidden[ch / 64] &= ~(uint64_t(1) << (ch % 64));
+            }
+            if (!k) {
+                break;
+            }
+            k = prefix_func[k - 1];
+        }
+    };
+
+    for (size_t i = 1; i < prefix_func.size(); ++i) {
+        if (prefix_func[i]) {
+            // pref[i] - 1 обязана лежать в цепочке границ s[0..i), а более длинные границы
+            // не должны продолжаться символом s[pref[i] - 1]. Спуск амортизирован, как в КМП
+            const size_t border = prefix_func[i] - 1;
+            vector_str[i] = vector_str[border];
+            size_t k = prefix_func[i - 1];
+            while (k > border && vector_str[k] != vector_str[i]) {
+                k = prefix_func[k - 1];
+            }
+            if (k != border) {
+                result.violation = i;
+                return result;
+            }
+            continue;
+        }
+        mark_border_chars(i, true);
+        size_t word = 0;
+        while (word < forbidden.size() && !~forbidden[word]) {
+            ++word;
+        }
+        size_t next_char = alphabet_size;
+        if (word < forbidden.size()) {
+            next_char = word * 64 + __builtin_ctzll(~forbidden[word]);
+        }
+        if (next_char >= alphabet_size) {
+            throw std::out_of_range("StringFromPrefix: alphabet is too small");
+        }
+        vector_str[i] = static_cast<Char>(base + next_char);
+        mark_border_chars(i, false);
+    }
+    return result;
+}
+
+template <class Index, class Char>
+Reconstruction<Char> ReconstructFromZ(const std::vector<Index>& z_func, Char base, size_t alphabet_size) {
+    const size_t length = z_func.size();
+    size_t bound_violation = std::string::npos;
+    if (length && z_func[0] != 0 && z_func[0] != length) {
+        bound_violation = 0;
+    }
+    for (size_t i = 1; i < length && bound_violation == std::string::npos; ++i) {
+        if (i + z_func[i] > length) {
+            bound_violation = i;
+        }
+    }
+    if (bound_violation != std::string::npos) {
+        return {std::vector<Char>(), bound_violation};
+    }
+    // z корректна <=> префикс-функция из неё корректна и переводится обратно в ту же z
+    auto prefix_func = PrefixFunctionFromZ(z_func);
+    auto result = ReconstructFromPrefix(prefix_func, base, alphabet_size);
+    auto z_back = ZFunctionFromPrefix(prefix_func);
+    for (size_t i = 1; i < std::min(result.violation, length); ++i) {
+        if (z_back[i] != z_func[i]) {
+            result.violation = i;
+            break;
+        }
+    }
+    return result;
+}
+
+template <class Index, class Char>
+std::vector<Char> StringFromPrefix(const std::vector<Index>& prefix_func,
+                                   Char base, size_t alphabet_size) {
+    auto result = ReconstructFromPrefix(prefix_func, base, alphabet_size);
+    if (result.violation != std::string::npos) {
+        throw std::invalid_argument("StringFromPrefix: not a prefix function");
+    }
+    return std::move(result.str);
+}
+
+#endif //Z_PREFIX_STRING_Z_PREFIX_H